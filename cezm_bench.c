@@ -0,0 +1,243 @@
+// synthetic schedules and a scaling benchmark for the parser, the solver and the text generator
+// usage: ./cezm_bench.bin [options] > bench.csv      times every stage at every size, see bench_usage()
+//        ./cezm_bench.bin -g -n 200 > plan.json     writes one generated schedule instead
+//
+// current limits on the size of a project, sizes past them are skipped:
+// - USER_TASKS_MAX (1024) tasks per user
+// - TASK_DEPENDENCIES_MAX (16) prereqs and dependents per task, neither is checked by the parser, so the generator keeps to it
+// - task and user memory and their hashtables only grow safely while empty (see tasks_reserve()), the editor stops at 64 tasks
+
+// standard system files
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h> // for dup()
+
+// external dependencies. only the SDL core for threads and timers, nothing is drawn
+#include <SDL2/SDL.h>
+
+// other files within this project
+#include "schedule.h"
+#include "editor.h"
+#include "generate.h"
+
+#define BENCH_SIZES_MAX 32
+
+enum BENCH_STAGE {
+  BENCH_STAGE_PARSE, // editor_parse_text()
+  BENCH_STAGE_EDIT, // editor_parse_text() again after one keystroke in the middle of the text
+  BENCH_STAGE_DEPENDENTS, // task_dependents_find_all()
+  BENCH_STAGE_SOLVE, // schedule_solve()
+  BENCH_STAGE_TEXT, // editor_text_from_data()
+  BENCH_STAGE_QTY
+};
+
+const char* bench_stage_names[BENCH_STAGE_QTY] = {"editor_parse_text", "editor_parse_edit", "task_dependents_find_all", "schedule_solve", "editor_text_from_data"};
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void bench_usage(FILE* out){
+  fprintf(out, "usage: cezm_bench.bin [-g] [-n tasks[,tasks...]] [-u users] [-d depth] [-f fan_in] [-x fixed_density] [-w no_sooner_density]\n");
+  fprintf(out, "                      [-r seed] [-k runs] [-s solver] [-b budget_ms] [-v]\n");
+  fprintf(out, "  -g               write one generated schedule of the first size to stdout, don't benchmark\n");
+  fprintf(out, "  -n tasks         sizes to run, comma separated. default 10,30,100,300,1000,3000,8000,10000,30000,100000\n");
+  fprintf(out, "  -u users         default tasks/32 + 2\n");
+  fprintf(out, "  -d depth         layers of the prereq graph, default about sqrt(tasks)\n");
+  fprintf(out, "  -f fan_in        most prereqs per task, up to %d. default 3\n", TASK_DEPENDENCIES_MAX);
+  fprintf(out, "  -x fixed_density share of first layer tasks with a fixed date, default 0.1\n");
+  fprintf(out, "  -w no_sooner_density share of the other tasks with a no_sooner date, default 0\n");
+  fprintf(out, "  -r seed          default 1, each run adds one\n");
+  fprintf(out, "  -k runs          runs per size, default 11\n");
+  fprintf(out, "  -s solver        solver number, default %d (%s)\n", SCHEDULE_SOLVER_LIST_PATH, schedule_solver_name(SCHEDULE_SOLVER_LIST_PATH));
+  fprintf(out, "  -b budget_ms     search time budget, default 1000\n");
+  fprintf(out, "  -v               keep the parser and solver logs\n");
+}
+
+
+double bench_elapsed_ms(uint64_t cpu_timer_start){
+  uint64_t cpu_timer_end = SDL_GetPerformanceCounter();
+  return ((double) cpu_timer_end - cpu_timer_start) * 1000 / ((double) SDL_GetPerformanceFrequency());
+}
+
+
+int bench_compare(const void* a, const void* b){
+  double x = *(const double*) a;
+  double y = *(const double*) b;
+  return (x > y) - (x < y);
+}
+
+
+// time each stage on runs freshly generated schedules of one size, results in ms by stage then run
+int bench_size(Generate_Options* options, size_t runs, uint8_t solver, double time_budget_ms, double* times){
+  for (size_t r=0; r<runs; ++r){
+    Generate_Options run_options = *options;
+    run_options.seed = options->seed + r;
+    Generate_Plan* plan = generate_plan(&run_options);
+    size_t text_length;
+    char* text = generate_plan_text(plan, &text_length);
+    Text_Buffer* text_buffer = generate_buffer_create(text, text_length, options->tasks);
+    free(text);
+    generate_plan_free(plan);
+
+    Task_Memory task_memory;
+    User_Memory user_memory;
+    tasks_init(&task_memory, &user_memory);
+    tasks_reserve(&task_memory, &user_memory, options->tasks, generate_users(options));
+    Text_Cursor* text_cursor = editor_cursor_create();
+    Schedule_Event_List* schedule_best = schedule_create();
+    Schedule_Event_List* schedule_working = schedule_create();
+    schedule_working->time_budget_ms = time_budget_ms;
+
+    uint64_t cpu_timer_start = SDL_GetPerformanceCounter();
+    editor_parse_text(&task_memory, &user_memory, text_buffer, text_cursor);
+    times[BENCH_STAGE_PARSE * runs + r] = bench_elapsed_ms(cpu_timer_start);
+
+    // a space typed at the end of the middle line, the cursor goes along
+    int middle = text_buffer->length / 2;
+    char* line_start = editor_buffer_view(text_buffer, middle, text_buffer->length);
+    int pos = middle + ((char*) memchr(line_start, (int) '\n', text_buffer->length - middle) - line_start);
+    editor_buffer_insert(text_buffer, pos, " ", 1);
+    text_cursor->pos[0] = pos + 1;
+    cpu_timer_start = SDL_GetPerformanceCounter();
+    editor_parse_text(&task_memory, &user_memory, text_buffer, text_cursor);
+    times[BENCH_STAGE_EDIT * runs + r] = bench_elapsed_ms(cpu_timer_start);
+
+    cpu_timer_start = SDL_GetPerformanceCounter();
+    task_dependents_find_all(&task_memory);
+    times[BENCH_STAGE_DEPENDENTS * runs + r] = bench_elapsed_ms(cpu_timer_start);
+
+    cpu_timer_start = SDL_GetPerformanceCounter();
+    int status = schedule_solve(&task_memory, schedule_best, schedule_working, solver);
+    times[BENCH_STAGE_SOLVE * runs + r] = bench_elapsed_ms(cpu_timer_start);
+
+    cpu_timer_start = SDL_GetPerformanceCounter();
+    editor_text_from_data(&task_memory, text_buffer, TRUE);
+    times[BENCH_STAGE_TEXT * runs + r] = bench_elapsed_ms(cpu_timer_start);
+
+    if ((task_memory.allocation_used != options->tasks) || (status != SUCCESS)){
+      fprintf(stderr, "[WARNING] %lu tasks, seed %lu: parsed %lu tasks, solve %s\n", options->tasks, run_options.seed, task_memory.allocation_used, (status == SUCCESS) ? "SUCCESS" : "FAILURE");
+    }
+
+    schedule_free(schedule_working);
+    schedule_free(schedule_best);
+    editor_cursor_destroy(text_cursor);
+    editor_buffer_destroy(text_buffer);
+    tasks_free(&task_memory, &user_memory);
+  }
+  return SUCCESS;
+}
+
+
+int main(int argc, char* argv[]){
+  Generate_Options options = {0, 0, 0, 3, 0.1, 0, 1};
+  size_t sizes[BENCH_SIZES_MAX] = {10, 30, 100, 300, 1000, 3000, 8000, 10000, 30000, 100000};
+  size_t size_qty = 10;
+  size_t runs = 11;
+  uint8_t solver = SCHEDULE_SOLVER_LIST_PATH;
+  double time_budget_ms = 1000;
+  uint8_t generate_only = FALSE;
+  uint8_t verbose = FALSE;
+
+  for (int a=1; a<argc; ++a){
+    if (strcmp(argv[a], "-g") == 0){
+      generate_only = TRUE;
+    }
+    else if (strcmp(argv[a], "-v") == 0){
+      verbose = TRUE;
+    }
+    else if (a+1 >= argc){
+      bench_usage(stderr);
+      return 2;
+    }
+    else if (strcmp(argv[a], "-n") == 0){
+      char* list = argv[++a];
+      size_qty = 0;
+      while ((*list != '\0') && (size_qty < BENCH_SIZES_MAX)){
+        sizes[size_qty] = strtoul(list, &list, 10);
+        size_qty += 1;
+        if (*list == ','){
+          ++list;
+        }
+      }
+    }
+    else if (strcmp(argv[a], "-u") == 0){
+      options.users = strtoul(argv[++a], NULL, 10);
+    }
+    else if (strcmp(argv[a], "-d") == 0){
+      options.depth = strtoul(argv[++a], NULL, 10);
+    }
+    else if (strcmp(argv[a], "-f") == 0){
+      options.fan_in = strtoul(argv[++a], NULL, 10);
+    }
+    else if (strcmp(argv[a], "-x") == 0){
+      options.fixed_density = atof(argv[++a]);
+    }
+    else if (strcmp(argv[a], "-w") == 0){
+      options.no_sooner_density = atof(argv[++a]);
+    }
+    else if (strcmp(argv[a], "-r") == 0){
+      options.seed = strtoul(argv[++a], NULL, 10);
+    }
+    else if (strcmp(argv[a], "-k") == 0){
+      runs = strtoul(argv[++a], NULL, 10);
+    }
+    else if (strcmp(argv[a], "-s") == 0){
+      solver = strtoul(argv[++a], NULL, 10);
+    }
+    else if (strcmp(argv[a], "-b") == 0){
+      time_budget_ms = atof(argv[++a]);
+    }
+    else{
+      bench_usage(stderr);
+      return 2;
+    }
+  }
+  if ((size_qty == 0) || (runs == 0) || (solver >= SCHEDULE_SOLVER_QTY)){
+    bench_usage(stderr);
+    return 2;
+  }
+
+  if (generate_only == TRUE){
+    options.tasks = sizes[0];
+    if (generate_fits(&options, stderr) == FALSE){
+      return 1;
+    }
+    Generate_Plan* plan = generate_plan(&options);
+    size_t text_length;
+    char* text = generate_plan_text(plan, &text_length);
+    fwrite(text, 1, text_length, stdout);
+    free(text);
+    generate_plan_free(plan);
+    return 0;
+  }
+
+  // the parser and solver log to stdout as they go. the CSV gets its own copy of stdout, the logs go nowhere
+  FILE* out = fdopen(dup(fileno(stdout)), "w");
+  if (verbose == FALSE){
+    if (freopen("/dev/null", "w", stdout) == NULL){
+      fprintf(stderr, "[WARNING] couldn't silence the logs\n");
+    }
+  }
+
+  fprintf(out, "tasks,users,solver,stage,runs,median_ms,p99_ms\n");
+  double* times = (double*) malloc(BENCH_STAGE_QTY * runs * sizeof(double));
+  for (size_t s=0; s<size_qty; ++s){
+    options.tasks = sizes[s];
+    if ((options.tasks == 0) || (generate_fits(&options, stderr) == FALSE)){
+      continue;
+    }
+    bench_size(&options, runs, solver, time_budget_ms, times);
+    for (size_t stage=0; stage<BENCH_STAGE_QTY; ++stage){
+      double* stage_times = times + stage * runs;
+      qsort(stage_times, runs, sizeof(double), bench_compare);
+      size_t p99 = (99 * runs + 99) / 100 - 1;
+      fprintf(out, "%lu,%lu,%s,%s,%lu,%.4lf,%.4lf\n", options.tasks, generate_users(&options), schedule_solver_name(solver), bench_stage_names[stage], runs, stage_times[runs / 2], stage_times[p99]);
+    }
+    fflush(out);
+  }
+  free(times);
+  fclose(out);
+  return 0;
+}
@@ -0,0 +1,192 @@
+// headless solver. parses schedule files and solves them without opening a window, for batch runs and benchmarks
+// usage: ./cezm_solve.bin [-s solver] [-b budget_ms] [-q] [-v] file.json [file.json ...]
+
+// standard system files
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h> // for dup()
+
+// external dependencies. only the SDL core for threads and timers, nothing is drawn
+#include <SDL2/SDL.h>
+
+// other files within this project
+#include "schedule.h"
+#include "editor.h"
+
+// short names for the solvers on the command line, in enum SCHEDULE_SOLVER order
+const char* solve_solver_keys[SCHEDULE_SOLVER_QTY] = {"dfs", "bounded", "path", "finish", "portfolio", "parallel"};
+
+
+void solve_usage(FILE* out){
+  fprintf(out, "usage: cezm_solve.bin [-s solver] [-b budget_ms] [-q] [-v] file.json [file.json ...]\n");
+  fprintf(out, "  -s solver     one of");
+  for (size_t s=0; s<SCHEDULE_SOLVER_QTY; ++s){
+    fprintf(out, " %s", solve_solver_keys[s]);
+  }
+  fprintf(out, ", or its number. default dfs\n");
+  fprintf(out, "  -b budget_ms  stop searching after this long and keep the best so far, 0 for no limit. default 2000\n");
+  fprintf(out, "  -q            one summary line per file, no task dates\n");
+  fprintf(out, "  -v            keep the parser and solver logs\n");
+}
+
+
+// solver from its short name or number, SCHEDULE_SOLVER_QTY if neither
+uint8_t solve_solver_parse(char* arg){
+  for (size_t s=0; s<SCHEDULE_SOLVER_QTY; ++s){
+    if (strcmp(arg, solve_solver_keys[s]) == 0){
+      return s;
+    }
+  }
+  char* end;
+  unsigned long number = strtoul(arg, &end, 10);
+  if ((*arg != '\0') && (*end == '\0') && (number < SCHEDULE_SOLVER_QTY)){
+    return number;
+  }
+  return SCHEDULE_SOLVER_QTY;
+}
+
+
+// read a file into the text buffer. unlike editor_load_text() a missing file is an error, not a new project
+int solve_file_read(Text_Buffer* text_buffer, const char* filename, FILE* out){
+  FILE* fd = fopen(filename, "r");
+  if (fd == NULL){
+    fprintf(out, "%s: FAILURE, can't open the file\n", filename);
+    return FAILURE;
+  }
+  editor_buffer_read(text_buffer, fd);
+  fclose(fd);
+  return SUCCESS;
+}
+
+
+// parse and solve one file, and print the result to out
+int solve_file(const char* filename, uint8_t solver, double time_budget_ms, uint8_t quiet, FILE* out){
+  Task_Memory task_memory;
+  User_Memory user_memory;
+  tasks_init(&task_memory, &user_memory);
+  Text_Buffer* text_buffer = editor_buffer_init();
+  Text_Cursor* text_cursor = editor_cursor_create();
+  Schedule_Event_List* schedule_best = schedule_create();
+  Schedule_Event_List* schedule_working = schedule_create();
+  schedule_working->time_budget_ms = time_budget_ms;
+
+  int status = solve_file_read(text_buffer, filename, out);
+  if (status == SUCCESS){
+    // the whole file gets parsed, so make room for all of it first. a task per '{' line at most, and a user per ':'
+    // or ','
+    Scan_Index* scan = &text_buffer->scan;
+    scan_text(scan, editor_buffer_view(text_buffer, 0, text_buffer->length), 0, text_buffer->length);
+    size_t task_qty = 0;
+    for (size_t l=0; l<scan->line_qty; ++l){
+      if ((scan->lines[l].marks & SCAN_MARK_OPEN) != 0){
+        task_qty += 1;
+      }
+    }
+    tasks_reserve(&task_memory, &user_memory, task_qty, scan->mark_qty);
+
+    uint64_t cpu_timer_start = SDL_GetPerformanceCounter();
+    for (size_t t=0; t<task_memory.allocation_total; ++t){
+      task_memory.tasks[t].mode_edit = TRUE;
+    }
+    editor_parse_text(&task_memory, &user_memory, text_buffer, text_cursor);
+    uint64_t cpu_timer_end = SDL_GetPerformanceCounter();
+    double parse_ms = ((double) cpu_timer_end - cpu_timer_start) * 1000 / ((double) SDL_GetPerformanceFrequency());
+
+    status = schedule_solve_threaded(&task_memory, schedule_best, schedule_working, solver);
+
+    char date_start[11] = "-";
+    char date_end[11] = "-";
+    if (status == SUCCESS){
+      text_append_date(date_start, schedule_best->day_start);
+      text_append_date(date_end, schedule_best->day_end);
+    }
+    fprintf(out, "%s: %s, solver: %s, tasks: %lu, duration: %lu days (%s to %s)%s, parse: %.3lf ms, solve: %.3lf ms, nodes: %lu, pruned: %lu, backtracks: %lu\n",
+      filename, (status == SUCCESS) ? "SUCCESS" : "FAILURE", schedule_solver_name(solver), task_memory.allocation_used,
+      schedule_best->day_duration, date_start, date_end,
+      (schedule_best->optimal == TRUE) ? " optimal" : ((schedule_best->timed_out == TRUE) ? " time limit" : ""),
+      parse_ms, schedule_best->solve_time_ms, schedule_best->search_nodes, schedule_best->search_prunes, schedule_best->stats.backtracks);
+
+    if ((status == SUCCESS) && (quiet == FALSE)){
+      for (size_t t=0; t<task_memory.allocation_total; ++t){
+        Task* task = task_memory.tasks + t;
+        if (task->trash == FALSE){
+          text_append_date(date_start, task->day_start);
+          text_append_date(date_end, task->day_end);
+          fprintf(out, "  %.*s %s %s\n", (int) task->task_name_length, task->task_name, date_start, date_end);
+        }
+      }
+    }
+  }
+
+  schedule_free(schedule_working);
+  schedule_free(schedule_best);
+  editor_cursor_destroy(text_cursor);
+  editor_buffer_destroy(text_buffer);
+  tasks_free(&task_memory, &user_memory);
+  return status;
+}
+
+
+int main(int argc, char* argv[]){
+  uint8_t solver = SCHEDULE_SOLVER_DFS;
+  double time_budget_ms = 2000;
+  uint8_t quiet = FALSE;
+  uint8_t verbose = FALSE;
+
+  int a = 1;
+  for (; (a < argc) && (argv[a][0] == '-'); ++a){
+    if ((strcmp(argv[a], "-s") == 0) && (a+1 < argc)){
+      solver = solve_solver_parse(argv[++a]);
+      if (solver == SCHEDULE_SOLVER_QTY){
+        fprintf(stderr, "unknown solver '%s'\n", argv[a]);
+        solve_usage(stderr);
+        return 2;
+      }
+    }
+    else if ((strcmp(argv[a], "-b") == 0) && (a+1 < argc)){
+      time_budget_ms = atof(argv[++a]);
+    }
+    else if (strcmp(argv[a], "-q") == 0){
+      quiet = TRUE;
+    }
+    else if (strcmp(argv[a], "-v") == 0){
+      verbose = TRUE;
+    }
+    else{
+      solve_usage(stderr);
+      return 2;
+    }
+  }
+  if (a == argc){
+    solve_usage(stderr);
+    return 2;
+  }
+
+  // the parser and solver log to stdout as they go. results get their own copy of stdout, the logs go nowhere
+  FILE* out = fdopen(dup(fileno(stdout)), "w");
+  if (verbose == FALSE){
+    if (freopen("/dev/null", "w", stdout) == NULL){
+      fprintf(stderr, "[WARNING] couldn't silence the logs\n");
+    }
+  }
+
+  size_t solved_qty = 0;
+  size_t file_qty = argc - a;
+  uint64_t cpu_timer_start = SDL_GetPerformanceCounter();
+  for (; a < argc; ++a){
+    if (solve_file(argv[a], solver, time_budget_ms, quiet, out) == SUCCESS){
+      solved_qty += 1;
+    }
+    fflush(out);
+  }
+  uint64_t cpu_timer_end = SDL_GetPerformanceCounter();
+  double cpu_timer_elapsed = ((double) cpu_timer_end - cpu_timer_start) / ((double) SDL_GetPerformanceFrequency());
+  if (file_qty > 1){
+    fprintf(out, "solved %lu of %lu files in %.3lf s\n", solved_qty, file_qty, cpu_timer_elapsed);
+  }
+  fclose(out);
+
+  return (solved_qty == file_qty) ? 0 : 1;
+}
@@ -0,0 +1,531 @@
+// differential verification of the solvers. generates small random plans, solves each one with every solver mode,
+// checks every result against the plan with its own checker, and compares makespans against the reference DFS.
+// a failing plan is shrunk while it still fails the same way, and written out as a schedule file
+// usage: ./cezm_verify.bin [-c cases] [-n max_tasks] [-r seed] [-b budget_ms] [-o dir] [-v]
+
+// standard system files
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h> // for dup()
+
+// external dependencies. only the SDL core for threads and timers, nothing is drawn
+#include <SDL2/SDL.h>
+
+// other files within this project
+#include "schedule.h"
+#include "editor.h"
+#include "generate.h"
+
+#define VERIFY_WHY_LENGTH 160
+
+enum VERIFY_RUN {
+  VERIFY_RUN_SOLVE, // schedule_solve()
+  VERIFY_RUN_THREADED, // schedule_solve_threaded(), islands, portfolio or parallel DFS
+  VERIFY_RUN_INCREMENTAL, // schedule_solve(), change a duration or a fixed date, then schedule_solve_incremental()
+  VERIFY_RUN_SNAPSHOT // the same, on a schedule_snapshot_take() copy like the editor's worker, then published back
+};
+
+enum VERIFY_FAIL {
+  VERIFY_FAIL_NONE,
+  VERIFY_FAIL_INVALID, // the schedule breaks the plan
+  VERIFY_FAIL_UNSOLVED, // an exact solver found nothing where the reference did
+  VERIFY_FAIL_WORSE, // an exact solver found a longer schedule than the reference
+  VERIFY_FAIL_REFERENCE // the reference found nothing where another solver did
+};
+
+const char* verify_fail_names[] = {"none", "invalid schedule", "no schedule", "longer than the reference", "reference found no schedule"};
+
+typedef struct Verify_Mode{
+  const char* name;
+  uint8_t run; // enum VERIFY_RUN
+  uint8_t solver;
+  uint8_t exact; // if TRUE, must do at least as well as the reference whenever neither ran out of time
+} Verify_Mode;
+
+// the first mode is the reference
+#define VERIFY_MODE_QTY 10
+Verify_Mode verify_modes[VERIFY_MODE_QTY] = {
+  {"dfs", VERIFY_RUN_SOLVE, SCHEDULE_SOLVER_DFS, TRUE},
+  {"bounded", VERIFY_RUN_SOLVE, SCHEDULE_SOLVER_DFS_BOUNDED, TRUE},
+  {"path", VERIFY_RUN_SOLVE, SCHEDULE_SOLVER_LIST_PATH, FALSE},
+  {"finish", VERIFY_RUN_SOLVE, SCHEDULE_SOLVER_LIST_FINISH, FALSE},
+  {"islands_dfs", VERIFY_RUN_THREADED, SCHEDULE_SOLVER_DFS, TRUE},
+  {"islands_bounded", VERIFY_RUN_THREADED, SCHEDULE_SOLVER_DFS_BOUNDED, TRUE},
+  {"portfolio", VERIFY_RUN_THREADED, SCHEDULE_SOLVER_PORTFOLIO, TRUE},
+  {"parallel", VERIFY_RUN_THREADED, SCHEDULE_SOLVER_DFS_PARALLEL, TRUE},
+  {"incremental", VERIFY_RUN_INCREMENTAL, SCHEDULE_SOLVER_LIST_PATH, FALSE},
+  {"snapshot", VERIFY_RUN_SNAPSHOT, SCHEDULE_SOLVER_DFS, FALSE}
+};
+
+typedef struct Verify_Result{
+  int status;
+  uint8_t valid;
+  uint8_t timed_out;
+  uint64_t duration;
+  char why[VERIFY_WHY_LENGTH]; // first thing the checker found wrong
+} Verify_Result;
+
+
+void verify_usage(FILE* out){
+  fprintf(out, "usage: cezm_verify.bin [-c cases] [-n max_tasks] [-r seed] [-b budget_ms] [-o dir] [-v]\n");
+  fprintf(out, "  -c cases      random plans to check, default 200\n");
+  fprintf(out, "  -n max_tasks  largest plan, default 8. the reference DFS is exhaustive, keep this small\n");
+  fprintf(out, "  -r seed       seed of the first plan, default 1, each plan adds one\n");
+  fprintf(out, "  -b budget_ms  search time budget per solve, default 2000. a solve that runs out isn't compared\n");
+  fprintf(out, "  -o dir        where shrunk failing plans are written, default .\n");
+  fprintf(out, "  -v            keep the parser and solver logs\n");
+}
+
+
+// the change an incremental run makes after its first solve: the last task runs longer, or the last fixed date moves
+// a week earlier or later, by the size of the plan. returns the plan task it changed
+size_t verify_incremental_change(Generate_Plan* plan){
+  size_t fixed = plan->task_qty;
+  for (size_t t=0; t<plan->task_qty; ++t){
+    if (plan->tasks[t].fixed != GENERATE_FIXED_NONE){
+      fixed = t;
+    }
+  }
+  if ((plan->task_qty % 3 == 0) || (fixed == plan->task_qty)){
+    plan->tasks[plan->task_qty - 1].duration += 2;
+    return plan->task_qty - 1;
+  }
+  if (plan->task_qty % 3 == 1){
+    plan->tasks[fixed].fixed_day -= 7;
+  }
+  else{
+    plan->tasks[fixed].fixed_day += 7;
+  }
+  return fixed;
+}
+
+
+// check a solved schedule against the plan it came from. uses only the plan and the solved dates, none of the
+// solver's own bookkeeping, so a bug shared by the solvers can't hide itself. TRUE if valid, otherwise why not
+int verify_check(Generate_Plan* plan, Task** by_plan, Schedule_Event_List* schedule_best, char* why){
+  uint64_t day_first = UINT64_MAX;
+  uint64_t day_last = 0;
+  for (size_t t=0; t<plan->task_qty; ++t){
+    Generate_Task* planned = plan->tasks + t;
+    Task* task = by_plan[t];
+    if (task == NULL){
+      snprintf(why, VERIFY_WHY_LENGTH, "t%lu is missing", t);
+      return FALSE;
+    }
+    if (task->day_end + 1 != task->day_start + planned->duration){
+      snprintf(why, VERIFY_WHY_LENGTH, "t%lu runs %lu to %lu, not %lu days", t, task->day_start, task->day_end, planned->duration);
+      return FALSE;
+    }
+    if ((planned->fixed == GENERATE_FIXED_START) && (task->day_start != planned->fixed_day)){
+      snprintf(why, VERIFY_WHY_LENGTH, "t%lu starts on %lu, fixed_start is %lu", t, task->day_start, planned->fixed_day);
+      return FALSE;
+    }
+    if ((planned->fixed == GENERATE_FIXED_END) && (task->day_end != planned->fixed_day)){
+      snprintf(why, VERIFY_WHY_LENGTH, "t%lu ends on %lu, fixed_end is %lu", t, task->day_end, planned->fixed_day);
+      return FALSE;
+    }
+    if ((planned->no_sooner > 0) && (task->day_start < planned->no_sooner)){
+      snprintf(why, VERIFY_WHY_LENGTH, "t%lu starts on %lu, no_sooner is %lu", t, task->day_start, planned->no_sooner);
+      return FALSE;
+    }
+    for (size_t p=0; p<planned->prereq_qty; ++p){
+      Task* prereq = by_plan[planned->prereqs[p]];
+      if (task->day_start <= prereq->day_end){
+        snprintf(why, VERIFY_WHY_LENGTH, "t%lu starts on %lu, before its prereq t%lu ends on %lu", t, task->day_start, planned->prereqs[p], prereq->day_end);
+        return FALSE;
+      }
+    }
+    // fixed tasks may overlap each other, see schedule_window_timetable()
+    for (size_t o=0; o<t; ++o){
+      Task* other = by_plan[o];
+      if ((planned->fixed != GENERATE_FIXED_NONE) && (plan->tasks[o].fixed != GENERATE_FIXED_NONE)){
+        continue;
+      }
+      if ((plan->tasks[o].user == planned->user) && (task->day_start <= other->day_end) && (other->day_start <= task->day_end)){
+        snprintf(why, VERIFY_WHY_LENGTH, "u%lu has t%lu (%lu to %lu) and t%lu (%lu to %lu) at once", planned->user, o, other->day_start, other->day_end, t, task->day_start, task->day_end);
+        return FALSE;
+      }
+    }
+    if (task->day_start < day_first){
+      day_first = task->day_start;
+    }
+    if (task->day_end > day_last){
+      day_last = task->day_end;
+    }
+  }
+  if ((plan->task_qty > 0) && ((schedule_best->day_start != day_first) || (schedule_best->day_end != day_last) || (schedule_best->day_duration != day_last - day_first))){
+    snprintf(why, VERIFY_WHY_LENGTH, "reports %lu to %lu, %lu days, the tasks run %lu to %lu", schedule_best->day_start, schedule_best->day_end, schedule_best->day_duration, day_first, day_last);
+    return FALSE;
+  }
+  return TRUE;
+}
+
+
+// TRUE if every island of the plan has a fixed task. the solvers are built around that (see schedule_solve()),
+// and each puts an island without one on whatever day it likes, so those makespans can't be compared
+int verify_anchored(Generate_Plan* plan){
+  size_t* island = (size_t*) malloc((plan->task_qty + 1) * sizeof(size_t));
+  for (size_t t=0; t<plan->task_qty; ++t){
+    island[t] = t;
+  }
+  // tasks joined by a prereq or a user take the lower label, until no label changes
+  uint8_t changed = TRUE;
+  while (changed == TRUE){
+    changed = FALSE;
+    for (size_t t=0; t<plan->task_qty; ++t){
+      Generate_Task* task = plan->tasks + t;
+      for (size_t o=0; o<plan->task_qty; ++o){
+        uint8_t joined = (plan->tasks[o].user == task->user);
+        for (size_t p=0; p<task->prereq_qty; ++p){
+          if (task->prereqs[p] == o){
+            joined = TRUE;
+          }
+        }
+        if ((joined == TRUE) && (island[o] != island[t])){
+          size_t low = (island[o] < island[t]) ? island[o] : island[t];
+          island[o] = low;
+          island[t] = low;
+          changed = TRUE;
+        }
+      }
+    }
+  }
+
+  int anchored = TRUE;
+  for (size_t i=0; i<plan->task_qty; ++i){
+    uint8_t used = FALSE;
+    uint8_t fixed = FALSE;
+    for (size_t t=0; t<plan->task_qty; ++t){
+      if (island[t] == i){
+        used = TRUE;
+        fixed |= (plan->tasks[t].fixed != GENERATE_FIXED_NONE);
+      }
+    }
+    if ((used == TRUE) && (fixed == FALSE)){
+      anchored = FALSE;
+    }
+  }
+  free(island);
+  return anchored;
+}
+
+
+// parse the plan's text into a fresh model, solve it in one mode and check the result
+void verify_solve(Generate_Plan* plan, Verify_Mode* mode, double time_budget_ms, Verify_Result* result){
+  size_t text_length;
+  char* text = generate_plan_text(plan, &text_length);
+  Text_Buffer* text_buffer = generate_buffer_create(text, text_length, plan->task_qty);
+  free(text);
+
+  Task_Memory task_memory;
+  User_Memory user_memory;
+  tasks_init(&task_memory, &user_memory);
+  tasks_reserve(&task_memory, &user_memory, plan->task_qty, plan->user_qty);
+  for (size_t t=0; t<task_memory.allocation_total; ++t){
+    task_memory.tasks[t].mode_edit = TRUE;
+  }
+  Text_Cursor* text_cursor = editor_cursor_create();
+  Schedule_Event_List* schedule_best = schedule_create();
+  Schedule_Event_List* schedule_working = schedule_create();
+  schedule_working->time_budget_ms = time_budget_ms;
+  editor_parse_text(&task_memory, &user_memory, text_buffer, text_cursor);
+
+  // plan task t is named "t<t>"
+  Task** by_plan = (Task**) calloc(plan->task_qty + 1, sizeof(Task*));
+  for (size_t t=0; t<task_memory.allocation_total; ++t){
+    Task* task = task_memory.tasks + t;
+    if ((task->trash == FALSE) && (task->task_name_length > 1) && (task->task_name[0] == 't')){
+      size_t index = strtoul(task->task_name + 1, NULL, 10);
+      if (index < plan->task_qty){
+        by_plan[index] = task;
+      }
+    }
+  }
+
+  Generate_Plan* solved_plan = plan;
+  char snapshot_why[VERIFY_WHY_LENGTH] = "";
+  if (mode->run == VERIFY_RUN_SOLVE){
+    result->status = schedule_solve(&task_memory, schedule_best, schedule_working, mode->solver);
+  }
+  else if (mode->run == VERIFY_RUN_THREADED){
+    result->status = schedule_solve_threaded(&task_memory, schedule_best, schedule_working, mode->solver);
+  }
+  else{
+    result->status = schedule_solve(&task_memory, schedule_best, schedule_working, mode->solver);
+    Generate_Plan* changed_plan = generate_plan_copy(plan);
+    size_t c = verify_incremental_change(changed_plan);
+    Task* changed = by_plan[c];
+    if ((result->status != SUCCESS) || (changed == NULL)){
+      generate_plan_free(changed_plan);
+    }
+    else{
+      // what the parser would make of the changed text
+      solved_plan = changed_plan;
+      Generate_Task* planned = solved_plan->tasks + c;
+      changed->day_duration = planned->duration;
+      if (planned->fixed == GENERATE_FIXED_START){
+        changed->day_start = planned->fixed_day;
+      }
+      else if (planned->fixed == GENERATE_FIXED_END){
+        changed->day_end = planned->fixed_day;
+      }
+      if (mode->run == VERIFY_RUN_INCREMENTAL){
+        result->status = schedule_solve_incremental(&task_memory, schedule_best, schedule_working, mode->solver);
+      }
+      else{
+        // the copy must keep exactly what the model itself would, or the worker re-places everything
+        Schedule_Snapshot snapshot;
+        memset(&snapshot, 0, sizeof(Schedule_Snapshot));
+        snapshot.best = schedule_create();
+        snapshot.working = schedule_create();
+        snapshot.working->time_budget_ms = time_budget_ms;
+        schedule_snapshot_take(&snapshot, &task_memory, &user_memory, schedule_best);
+        int status = schedule_solve_incremental(&task_memory, schedule_best, schedule_working, mode->solver);
+        size_t repaired = schedule_best->repaired_qty;
+        result->status = schedule_solve_incremental(&snapshot.task_memory, snapshot.best, snapshot.working, mode->solver);
+        if ((status != result->status) || (snapshot.best->repaired_qty != repaired) || (snapshot.best->repaired_qty >= plan->task_qty)){
+          snprintf(snapshot_why, VERIFY_WHY_LENGTH, "the snapshot repaired %lu of %lu tasks, the model itself %lu", snapshot.best->repaired_qty, plan->task_qty, repaired);
+        }
+        schedule_snapshot_publish(snapshot.best, snapshot.task_memory.tasks, &task_memory, schedule_best);
+        schedule_snapshot_free(&snapshot);
+      }
+    }
+  }
+
+  result->timed_out = schedule_best->timed_out;
+  result->duration = schedule_best->day_duration;
+  result->valid = TRUE;
+  result->why[0] = '\0';
+  if (result->status == SUCCESS){
+    result->valid = verify_check(solved_plan, by_plan, schedule_best, result->why);
+  }
+  if ((result->valid == TRUE) && (snapshot_why[0] != '\0')){
+    result->valid = FALSE;
+    memcpy(result->why, snapshot_why, VERIFY_WHY_LENGTH);
+  }
+
+  if (solved_plan != plan){
+    generate_plan_free(solved_plan);
+  }
+  free(by_plan);
+  schedule_free(schedule_working);
+  schedule_free(schedule_best);
+  editor_cursor_destroy(text_cursor);
+  editor_buffer_destroy(text_buffer);
+  tasks_free(&task_memory, &user_memory);
+}
+
+
+// how mode m does on the plan, judged on its own and against the reference. the reference is solved again for
+// every mode other than itself, so the shrinker can call this on any smaller plan
+uint8_t verify_mode_fail(Generate_Plan* plan, size_t m, double time_budget_ms, char* why){
+  Verify_Result result;
+  verify_solve(plan, verify_modes + m, time_budget_ms, &result);
+  if (result.valid == FALSE){
+    snprintf(why, VERIFY_WHY_LENGTH, "%s", result.why);
+    return VERIFY_FAIL_INVALID;
+  }
+  if ((m == 0) || (verify_modes[m].exact == FALSE) || (result.timed_out == TRUE) || (verify_anchored(plan) == FALSE)){
+    return VERIFY_FAIL_NONE;
+  }
+
+  Verify_Result reference;
+  verify_solve(plan, verify_modes, time_budget_ms, &reference);
+  if ((reference.valid == FALSE) || (reference.timed_out == TRUE)){
+    return VERIFY_FAIL_NONE;
+  }
+  if ((reference.status == SUCCESS) && (result.status != SUCCESS)){
+    snprintf(why, VERIFY_WHY_LENGTH, "the reference took %lu days", reference.duration);
+    return VERIFY_FAIL_UNSOLVED;
+  }
+  if ((reference.status == SUCCESS) && (result.duration > reference.duration)){
+    snprintf(why, VERIFY_WHY_LENGTH, "%lu days, the reference took %lu", result.duration, reference.duration);
+    return VERIFY_FAIL_WORSE;
+  }
+  if ((reference.status != SUCCESS) && (result.status == SUCCESS)){
+    snprintf(why, VERIFY_WHY_LENGTH, "%s found %lu days", verify_modes[m].name, result.duration);
+    return VERIFY_FAIL_REFERENCE;
+  }
+  return VERIFY_FAIL_NONE;
+}
+
+
+// smallest plan that still fails mode m the same way. drops tasks, then prereqs, then dates, then shortens durations,
+// and goes round again until nothing more can go
+Generate_Plan* verify_shrink(Generate_Plan* plan, size_t m, uint8_t fail, double time_budget_ms, char* why){
+  Generate_Plan* smallest = generate_plan_copy(plan);
+  char why_try[VERIFY_WHY_LENGTH];
+  uint8_t shrunk = TRUE;
+  while (shrunk == TRUE){
+    shrunk = FALSE;
+    for (size_t t=smallest->task_qty; (t > 0) && (smallest->task_qty > 1); --t){
+      Generate_Plan* attempt = generate_plan_copy(smallest);
+      generate_plan_remove(attempt, t - 1);
+      if (verify_mode_fail(attempt, m, time_budget_ms, why_try) == fail){
+        generate_plan_free(smallest);
+        smallest = attempt;
+        memcpy(why, why_try, VERIFY_WHY_LENGTH);
+        shrunk = TRUE;
+      }
+      else{
+        generate_plan_free(attempt);
+      }
+    }
+
+    for (size_t t=0; t<smallest->task_qty; ++t){
+      for (size_t step=0; step<smallest->tasks[t].prereq_qty + 3; ++step){
+        Generate_Plan* attempt = generate_plan_copy(smallest);
+        Generate_Task* task = attempt->tasks + t;
+        uint8_t changed = FALSE;
+        if (step < task->prereq_qty){
+          memmove(task->prereqs + step, task->prereqs + step + 1, (task->prereq_qty - step - 1) * sizeof(size_t));
+          task->prereq_qty -= 1;
+          changed = TRUE;
+        }
+        else if ((step == task->prereq_qty) && (task->fixed != GENERATE_FIXED_NONE)){
+          task->fixed = GENERATE_FIXED_NONE;
+          changed = TRUE;
+        }
+        else if ((step == task->prereq_qty + 1) && (task->no_sooner > 0)){
+          task->no_sooner = 0;
+          changed = TRUE;
+        }
+        else if ((step == task->prereq_qty + 2) && (task->duration > 1)){
+          task->duration = 1;
+          changed = TRUE;
+        }
+        if ((changed == TRUE) && (verify_mode_fail(attempt, m, time_budget_ms, why_try) == fail)){
+          generate_plan_free(smallest);
+          smallest = attempt;
+          memcpy(why, why_try, VERIFY_WHY_LENGTH);
+          shrunk = TRUE;
+        }
+        else{
+          generate_plan_free(attempt);
+        }
+      }
+    }
+  }
+  return smallest;
+}
+
+
+// write a failing plan where it can be opened in the editor or run through cezm_solve.bin. returns the file name
+int verify_write(Generate_Plan* plan, const char* dir, uint64_t seed, const char* mode_name, char* filename, size_t filename_max){
+  snprintf(filename, filename_max, "%s/verify_fail_%lu_%s.json", dir, seed, mode_name);
+  FILE* fd = fopen(filename, "w");
+  if (fd == NULL){
+    return FAILURE;
+  }
+  size_t text_length;
+  char* text = generate_plan_text(plan, &text_length);
+  fwrite(text, 1, text_length, fd);
+  free(text);
+  fclose(fd);
+  return SUCCESS;
+}
+
+
+int main(int argc, char* argv[]){
+  size_t cases = 200;
+  size_t max_tasks = 8;
+  uint64_t seed = 1;
+  double time_budget_ms = 2000;
+  const char* dir = ".";
+  uint8_t verbose = FALSE;
+
+  for (int a=1; a<argc; ++a){
+    if (strcmp(argv[a], "-v") == 0){
+      verbose = TRUE;
+    }
+    else if (a+1 >= argc){
+      verify_usage(stderr);
+      return 2;
+    }
+    else if (strcmp(argv[a], "-c") == 0){
+      cases = strtoul(argv[++a], NULL, 10);
+    }
+    else if (strcmp(argv[a], "-n") == 0){
+      max_tasks = strtoul(argv[++a], NULL, 10);
+    }
+    else if (strcmp(argv[a], "-r") == 0){
+      seed = strtoul(argv[++a], NULL, 10);
+    }
+    else if (strcmp(argv[a], "-b") == 0){
+      time_budget_ms = atof(argv[++a]);
+    }
+    else if (strcmp(argv[a], "-o") == 0){
+      dir = argv[++a];
+    }
+    else{
+      verify_usage(stderr);
+      return 2;
+    }
+  }
+  if (max_tasks < 2){
+    verify_usage(stderr);
+    return 2;
+  }
+
+  // the parser and solver log to stdout as they go. the results get their own copy of stdout, the logs go nowhere
+  FILE* out = fdopen(dup(fileno(stdout)), "w");
+  if (verbose == FALSE){
+    if (freopen("/dev/null", "w", stdout) == NULL){
+      fprintf(stderr, "[WARNING] couldn't silence the logs\n");
+    }
+  }
+
+  size_t fail_qty[VERIFY_MODE_QTY] = {0};
+  size_t fail_total = 0;
+  uint64_t cpu_timer_start = SDL_GetPerformanceCounter();
+  for (size_t c=0; c<cases; ++c){
+    // the shape of each plan comes from its seed too, so one seed is enough to get a plan back
+    uint64_t state = (seed + c) * 2654435761u + 7;
+    Generate_Options options;
+    options.tasks = 2 + generate_random(&state) % (max_tasks - 1);
+    options.users = 1 + generate_random(&state) % 3;
+    options.depth = 0;
+    options.fan_in = 1 + generate_random(&state) % 3;
+    options.fixed_density = 0.3;
+    options.no_sooner_density = 0.2;
+    options.seed = seed + c;
+    Generate_Plan* plan = generate_plan(&options);
+
+    for (size_t m=0; m<VERIFY_MODE_QTY; ++m){
+      char why[VERIFY_WHY_LENGTH];
+      uint8_t fail = verify_mode_fail(plan, m, time_budget_ms, why);
+      if (fail == VERIFY_FAIL_NONE){
+        continue;
+      }
+      fail_qty[m] += 1;
+      fail_total += 1;
+      fprintf(out, "[VERIFY] seed %lu, %lu tasks, %s: %s, %s\n", options.seed, plan->task_qty, verify_modes[m].name, verify_fail_names[fail], why);
+
+      Generate_Plan* smallest = verify_shrink(plan, m, fail, time_budget_ms, why);
+      char filename[512];
+      if (verify_write(smallest, dir, options.seed, verify_modes[m].name, filename, sizeof(filename)) == SUCCESS){
+        fprintf(out, "  shrunk to %lu tasks: %s, written to %s\n", smallest->task_qty, why, filename);
+      }
+      else{
+        fprintf(out, "  shrunk to %lu tasks: %s, couldn't write %s\n", smallest->task_qty, why, filename);
+      }
+      generate_plan_free(smallest);
+      fflush(out);
+    }
+    generate_plan_free(plan);
+  }
+
+  uint64_t cpu_timer_end = SDL_GetPerformanceCounter();
+  double cpu_timer_elapsed = ((double) cpu_timer_end - cpu_timer_start) / ((double) SDL_GetPerformanceFrequency());
+  fprintf(out, "checked %lu plans in %lu modes in %.3lf s, %lu failures\n", cases, (size_t) VERIFY_MODE_QTY, cpu_timer_elapsed, fail_total);
+  for (size_t m=0; m<VERIFY_MODE_QTY; ++m){
+    if (fail_qty[m] > 0){
+      fprintf(out, "  %s: %lu\n", verify_modes[m].name, fail_qty[m]);
+    }
+  }
+  fclose(out);
+
+  return (fail_total == 0) ? 0 : 1;
+}
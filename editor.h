@@ -0,0 +1,2765 @@
+#ifndef EDITOR_H
+#define EDITOR_H
+
+// the project model and its text: tasks, users, the text buffer and cursors, the parser and the text generator
+// nothing in here draws, so the editor (main.c) and the headless solver (cezm_solve.c) share it
+
+// standard system files
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <assert.h>
+#include <time.h>
+#include <ctype.h> // for isalnum()
+
+// external dependencies
+#include <SDL2/SDL.h>
+
+// other files within this project
+#include "schedule.h"
+#include "lib/hashtable.h"
+
+// viewport-editor related
+#define LINE_MAX_LENGTH 512
+#define EDITOR_BUFFER_LENGTH 1024 // what the text buffer starts with, it grows
+#define EDITOR_LINES_MAX 1024
+#define EDITOR_JOURNAL_BYTES (1<<20) // undo history of the editor text, the oldest is dropped past this
+#define JOURNAL_GROUP_START (1) // record flag, the first edit of a frame
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void tasks_init(Task_Memory* task_memory, User_Memory* user_memory){
+  task_memory->allocation_total = 64;
+  task_memory->allocation_used = 0;
+  task_memory->last_created = 0;
+  task_memory->tasks = (Task*) malloc(task_memory->allocation_total * sizeof(Task));
+  task_memory->hashtable = hash_table_create(HT_TASKS_MAX, HT_FREE_KEY);
+
+  for (size_t i=0; i<task_memory->allocation_total; ++i){
+    task_memory->tasks[i].trash = TRUE;
+  }
+  task_memory->editor_visited = (uint8_t*) malloc(task_memory->allocation_total * sizeof(uint8_t));
+  memset(task_memory->editor_visited, 0, task_memory->allocation_total);
+  task_memory->temp_status = (uint8_t*) malloc(task_memory->allocation_total * sizeof( *task_memory->temp_status));
+  task_memory->schedule_ready = (uint64_t*) malloc(schedule_ready_words(task_memory->allocation_total) * sizeof(uint64_t));
+  task_memory->schedule_pending = (uint64_t*) malloc(schedule_ready_words(task_memory->allocation_total) * sizeof(uint64_t));
+  printf("Task init() complete for %ld tasks\n", task_memory->allocation_total);
+
+  status_color_init();
+
+  user_memory->allocation_total = 8;
+  user_memory->allocation_used = 0;
+  user_memory->last_created = 0;
+  user_memory->users = (User*) malloc(user_memory->allocation_total * sizeof(User));
+  for (size_t i=0; i<user_memory->allocation_total; ++i){
+    user_memory->users[i].trash = TRUE;
+  }
+  user_memory->hashtable = hash_table_create(HT_USERS_MAX, HT_FREE_KEY);
+  user_memory->editor_visited = (uint8_t*) malloc(user_memory->allocation_total * sizeof(uint8_t));
+  memset(user_memory->editor_visited, 0, user_memory->allocation_total);
+}
+
+
+void tasks_free(Task_Memory* task_memory, User_Memory* user_memory){
+  printf("[STATUS] FREEING TASK TABLE\n");
+  hash_table_print(task_memory->hashtable);
+  hash_table_destroy(task_memory->hashtable);
+  free(task_memory->tasks);
+  free(task_memory->editor_visited);
+  free(task_memory->temp_status);
+  free(task_memory->schedule_ready);
+  free(task_memory->schedule_pending);
+
+  hash_table_print(user_memory->hashtable);
+  hash_table_destroy(user_memory->hashtable); 
+  free(user_memory->users);
+  free(user_memory->editor_visited);
+}
+
+
+// grow memory as needed to hold allocated tasks
+// don't shrink - avoid having to search and move active nodes into lower memory space in realtime
+// if needed user could save and restart to reduce memory footprint
+void task_memory_grow(Task_Memory* tm, size_t allocation_total){
+  if (allocation_total > tm->allocation_total){
+    uint64_t task_allocation_old = tm->allocation_total;
+    tm->allocation_total = allocation_total;
+    tm->tasks = (Task*) realloc(tm->tasks, tm->allocation_total * sizeof(Task));
+    tm->editor_visited = (uint8_t*) realloc(tm->editor_visited, tm->allocation_total * sizeof(uint8_t));
+    tm->temp_status = (uint8_t*) realloc(tm->temp_status, tm->allocation_total * sizeof( *tm->temp_status));
+    tm->schedule_ready = (uint64_t*) realloc(tm->schedule_ready, schedule_ready_words(tm->allocation_total) * sizeof(uint64_t));
+    tm->schedule_pending = (uint64_t*) realloc(tm->schedule_pending, schedule_ready_words(tm->allocation_total) * sizeof(uint64_t));
+
+    for (size_t i=task_allocation_old; i<tm->allocation_total; ++i){
+      tm->tasks[i].trash = TRUE;
+      tm->editor_visited[i] = FALSE;
+    }
+  }
+}
+
+void task_memory_management(Task_Memory* tm){
+  if (tm->allocation_used >= tm->allocation_total){
+    printf("[CAUTION] TASK MEMORY MANAGEMENT ACTIVATED, INCREASING MEMORY ALLOCATIONS\n");
+    task_memory_grow(tm, tm->allocation_total * 1.5);
+  }
+
+  // TODO some way to update has task_names_ht size.. would need to re-index all tasks :(
+}
+
+
+// only allowed to create a task in edit mode
+Task* task_create(Task_Memory* task_memory, char* task_name, size_t task_name_length){
+  Task* tasks = task_memory->tasks;
+
+  // find an empty slot to use for the task
+  do {
+    task_memory->last_created = (task_memory->last_created + 1) % task_memory->allocation_total;
+  } while (tasks[task_memory->last_created].trash == FALSE);
+  task_memory->allocation_used += 1;
+
+  Task* task = (tasks + task_memory->last_created);
+
+  // zero everything there. also brings mode out of trash mode
+  memset((void*) task, 0, sizeof(Task));
+  task->trash = FALSE;
+  task->task_name_length = task_name_length;
+  task->mode_edit = TRUE; 
+  task->mode_edit_temp = FALSE;
+  
+  // add to hash table
+  char* name = (char*) malloc(task_name_length+1);
+  memcpy(name, task_name, task_name_length);
+  name[task_name_length] = '\0';
+  hash_table_insert(task_memory->hashtable, name, (void*) task);
+  task->task_name = name;
+
+  return task;
+}
+
+
+Task* task_get(Task_Memory* task_memory, char* task_name, int task_name_length){
+  // use the hash table to find a pointer to the task based on the string name the user gives
+  // return NULL if the task does not exist and needs to be created
+  char name[128]; // TODO
+  assert(task_name_length < 128);
+  memcpy(name, task_name, task_name_length);
+  name[task_name_length] = '\0';
+  Task* task = (Task*) hash_table_get(task_memory->hashtable, name);
+  return task;
+}
+
+// check if the given user is already assigned to the given task
+uint8_t task_user_has(Task* task, User* user){
+  uint8_t result = FALSE;
+  for(size_t i=0; i<task->user_qty; ++i){
+    if (task->users[i] == user){
+      result = TRUE;
+    }
+  }
+  return result;
+}
+
+
+// add user to task if user is not already there
+void task_user_add(Task* task, User* user){
+  assert(task->user_qty < TASK_USERS_MAX);
+  assert(user->task_qty < USER_TASKS_MAX);
+
+  if (task_user_has(task, user) == FALSE){
+    task->users[task->user_qty] = user;
+    task->user_qty += 1;
+
+    user->tasks[user->task_qty] = task;
+    user->task_qty += 1;
+  }
+}
+
+
+// edits task struct to remove user pointer, and user struct to remove task pointer
+void task_user_remove(Task* task, User* user){
+  size_t id = 0;
+
+  // find the user pointer in the task struct
+  uint8_t found = 0;
+  for(size_t i=0; i<task->user_qty; ++i){
+    if (task->users[i] == user){
+      id = i;
+      found = 1;
+      break;
+    }
+  }
+
+  // now shuffle down all the remaining users, update the qty
+  if (found == 1){
+    for (size_t i=id; i<task->user_qty-1; ++i){
+      task->users[i] = task->users[i+1];
+    }
+    task->user_qty -= 1;
+  }
+
+  // now remove the task pointer from the user struct
+  uint8_t found2 = 0;
+  for(size_t i=0; i<user->task_qty; ++i){
+    if (user->tasks[i] == task){
+      id = i;
+      found2 = 1;
+      break;
+    }
+  }
+
+  // and shuffle down the remaining users
+  if (found2 == 1){
+    for (size_t i=id; i<user->task_qty; ++i){
+      user->tasks[i] = user->tasks[i+1];
+    }
+    user->task_qty -= 1;
+  }
+
+  assert(found == found2);
+}
+
+
+// look at a task, remove users you expected to see but did not
+void task_user_remove_unvisited(Task* task, User_Memory* user_memory){
+  if (task->user_qty > 0){
+    for (size_t u=task->user_qty; u>0; u--){
+      User* user = task->users[u-1];
+      size_t uindex = user - user_memory->users;
+      if (user_memory->editor_visited[uindex] == FALSE){
+        task_user_remove(task, user);
+      }
+    }
+  }
+}
+ 
+
+void task_destroy(Task_Memory* task_memory, Task* task){
+  assert(task->trash == FALSE); // don't try and remove already-removed tasks
+  task->trash = TRUE;
+  if (task_memory->allocation_used > 0){
+    task_memory->allocation_used -= 1;
+  }
+  printf("REMOVING tasks.name=%s..\n", task->task_name);
+  hash_table_remove(task_memory->hashtable, task->task_name);
+
+  // task_user_remove() shuffles the rest down, so take them off the end
+  while (task->user_qty > 0){
+    task_user_remove(task, task->users[task->user_qty - 1]);
+  }
+}
+
+
+void task_dependents_find_all(Task_Memory* task_memory){
+  Task* tasks = task_memory->tasks;
+
+  // clear previous info
+  for (size_t t=0; t<task_memory->allocation_total; ++t){
+    tasks[t].dependent_qty = 0;
+  }
+
+  // search and add
+  for( size_t t=0; t<task_memory->allocation_total; ++t){
+    if (tasks[t].trash == FALSE){
+      for (size_t i=0; i<tasks[t].prereq_qty; ++i){
+        Task* prereq = tasks[t].prereqs[i];
+        prereq->dependents[prereq->dependent_qty] = tasks+t;
+        prereq->dependent_qty += 1;
+      }
+    }
+  }
+}
+
+
+// add task to the dependents of prereq, in slot order like task_dependents_find_all() leaves them
+void task_dependent_add(Task* prereq, Task* task){
+  size_t i = prereq->dependent_qty;
+  while ((i > 0) && (prereq->dependents[i-1] > task)){
+    prereq->dependents[i] = prereq->dependents[i-1];
+    i -= 1;
+  }
+  prereq->dependents[i] = task;
+  prereq->dependent_qty += 1;
+}
+
+
+// take task off the dependents of prereq, once
+void task_dependent_remove(Task* prereq, Task* task){
+  for (size_t i=0; i<prereq->dependent_qty; ++i){
+    if (prereq->dependents[i] == task){
+      for (size_t j=i+1; j<prereq->dependent_qty; ++j){
+        prereq->dependents[j-1] = prereq->dependents[j];
+      }
+      prereq->dependent_qty -= 1;
+      return;
+    }
+  }
+}
+
+
+// is to a prereq of from, or of one of its prereqs and so on. walks only what's upstream of from
+// temp_status marks the tasks seen with 4 and puts them back to 0, it has to hold less than 4 everywhere before
+uint8_t task_prereq_reaches(Task_Memory* task_memory, Task* from, Task* to){
+  Task* tasks = task_memory->tasks;
+  size_t stack_max = 64;
+  size_t stack_qty = 0;
+  size_t seen_max = 64;
+  size_t seen_qty = 0;
+  Task** stack = (Task**) malloc(stack_max * sizeof(Task*));
+  Task** seen = (Task**) malloc(seen_max * sizeof(Task*));
+  uint8_t found = FALSE;
+
+  stack[stack_qty++] = from;
+  while ((stack_qty > 0) && (found == FALSE)){
+    Task* task = stack[--stack_qty];
+    if (task == to){
+      found = TRUE;
+    }
+    else if (task_memory->temp_status[task - tasks] != 4){
+      task_memory->temp_status[task - tasks] = 4;
+      if (seen_qty >= seen_max){
+        seen_max *= 2;
+        seen = (Task**) realloc(seen, seen_max * sizeof(Task*));
+      }
+      if (stack_qty + task->prereq_qty > stack_max){
+        stack_max = 2 * stack_max + task->prereq_qty;
+        stack = (Task**) realloc(stack, stack_max * sizeof(Task*));
+      }
+      seen[seen_qty++] = task;
+      for (size_t p=0; p<task->prereq_qty; ++p){
+        stack[stack_qty++] = task->prereqs[p];
+      }
+    }
+  }
+
+  for (size_t s=0; s<seen_qty; ++s){
+    task_memory->temp_status[seen[s] - tasks] = 0;
+  }
+  free(stack);
+  free(seen);
+  return found;
+}
+
+
+void task_name_generate(Task_Memory* task_memory, Task* base, char* result_name, int* result_length){
+  int i = 0;
+  Task* exists = NULL;
+  do {
+    ++i;
+    *result_length = sprintf(result_name, "%s%d", base->task_name, i);
+    exists = task_get(task_memory, result_name, *result_length);
+    if (i > 999){
+      printf("[ERROR] COULD NOT FIND A VALID NEW TASK NAME\n");
+      assert(0);
+    }
+  } while (exists != NULL);
+}
+
+
+// mark every task on a prereq loop, by finding the strongly connected components of the prereq graph (Tarjan)
+// returns how many tasks are on loops. linear in tasks and prereqs, and no recursion so deep chains are fine
+size_t task_cycles_find(Task_Memory* task_memory){
+  Task* tasks = task_memory->tasks;
+  size_t total = task_memory->allocation_total;
+  size_t* index = (size_t*) malloc(total * sizeof(size_t)); // visit order, SIZE_MAX until visited
+  size_t* lowlink = (size_t*) malloc(total * sizeof(size_t)); // earliest visited task reachable, still open
+  uint8_t* on_stack = (uint8_t*) malloc(total * sizeof(uint8_t));
+  size_t* stack = (size_t*) malloc(total * sizeof(size_t)); // tasks of components not yet closed
+  size_t* call = (size_t*) malloc(total * sizeof(size_t)); // the depth first walk
+  size_t* call_prereq = (size_t*) malloc(total * sizeof(size_t)); // next prereq to follow at each level
+  size_t stack_qty = 0;
+  size_t call_qty = 0;
+  size_t visited = 0;
+  size_t cycle_qty = 0;
+
+  for (size_t t=0; t<total; ++t){
+    tasks[t].cycle = FALSE;
+    index[t] = SIZE_MAX;
+    on_stack[t] = FALSE;
+  }
+
+  for (size_t root=0; root<total; ++root){
+    if ((tasks[root].trash == TRUE) || (index[root] != SIZE_MAX)){
+      continue;
+    }
+    index[root] = visited;
+    lowlink[root] = visited;
+    visited += 1;
+    stack[stack_qty++] = root;
+    on_stack[root] = TRUE;
+    call[call_qty] = root;
+    call_prereq[call_qty] = 0;
+    call_qty += 1;
+
+    while (call_qty > 0){
+      size_t v = call[call_qty-1];
+      if (call_prereq[call_qty-1] < tasks[v].prereq_qty){
+        Task* prereq = tasks[v].prereqs[call_prereq[call_qty-1]];
+        call_prereq[call_qty-1] += 1;
+        size_t w = prereq - tasks;
+        if (prereq->trash == TRUE){
+          continue;
+        }
+        if (index[w] == SIZE_MAX){
+          index[w] = visited;
+          lowlink[w] = visited;
+          visited += 1;
+          stack[stack_qty++] = w;
+          on_stack[w] = TRUE;
+          call[call_qty] = w;
+          call_prereq[call_qty] = 0;
+          call_qty += 1;
+        }
+        else if ((on_stack[w] == TRUE) && (index[w] < lowlink[v])){
+          lowlink[v] = index[w];
+        }
+        continue;
+      }
+
+      // every prereq of v is done. if nothing reached past v, v closes a component
+      if (lowlink[v] == index[v]){
+        size_t first = stack_qty;
+        do {
+          first -= 1;
+          on_stack[stack[first]] = FALSE;
+        } while (stack[first] != v);
+
+        uint8_t loop = (stack_qty - first > 1);
+        for (size_t i=0; i<tasks[v].prereq_qty; ++i){
+          if (tasks[v].prereqs[i] == tasks + v){
+            loop = TRUE; // its own prereq
+          }
+        }
+        if (loop == TRUE){
+          printf("[WARNING] prereq loop between tasks:");
+          for (size_t i=first; i<stack_qty; ++i){
+            tasks[stack[i]].cycle = TRUE;
+            printf(" %s", tasks[stack[i]].task_name);
+          }
+          printf("\n");
+          cycle_qty += stack_qty - first;
+        }
+        stack_qty = first;
+      }
+      call_qty -= 1;
+      if (call_qty > 0){
+        size_t u = call[call_qty-1];
+        if (lowlink[v] < lowlink[u]){
+          lowlink[u] = lowlink[v];
+        }
+      }
+    }
+  }
+
+  free(index);
+  free(lowlink);
+  free(on_stack);
+  free(stack);
+  free(call);
+  free(call_prereq);
+  return cycle_qty;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void user_memory_grow(User_Memory* um, size_t allocation_total){
+  if (allocation_total > um->allocation_total){
+    uint64_t user_allocation_old = um->allocation_total;
+    um->allocation_total = allocation_total;
+    um->users = (User*) realloc(um->users, um->allocation_total * sizeof(User));
+    um->editor_visited = (uint8_t*) realloc(um->editor_visited, um->allocation_total * sizeof(uint8_t));
+
+    for (size_t i=user_allocation_old; i<um->allocation_total; ++i){
+      um->users[i].trash = TRUE;
+      um->editor_visited[i] = FALSE;
+    }
+  }
+}
+
+void user_memory_management(User_Memory* um){
+  if (um->allocation_used >= um->allocation_total){
+    printf("[CAUTION] USER MEMORY MANAGEMENT ACTIVATED, INCREASING MEMORY ALLOCATIONS\n");
+    user_memory_grow(um, um->allocation_total * 1.5);
+  }
+}
+
+
+// make room up front for a project of known size. growing once tasks or users exist moves them out from under
+// every pointer to them, so this is only for empty memory, e.g. before parsing a whole file
+// the name hashtables can't grow at all, so while they're empty they're made again, at least twice the names they'll hold
+void tasks_reserve(Task_Memory* task_memory, User_Memory* user_memory, size_t task_qty, size_t user_qty){
+  assert((task_memory->allocation_used == 0) && (user_memory->allocation_used == 0));
+  task_memory_grow(task_memory, task_qty + 1);
+  user_memory_grow(user_memory, user_qty + 1);
+  if (2 * task_qty > task_memory->hashtable->size){
+    hash_table_destroy(task_memory->hashtable);
+    task_memory->hashtable = hash_table_create(2 * task_qty, HT_FREE_KEY);
+  }
+  if (2 * user_qty > user_memory->hashtable->size){
+    hash_table_destroy(user_memory->hashtable);
+    user_memory->hashtable = hash_table_create(2 * user_qty, HT_FREE_KEY);
+  }
+}
+
+
+User* user_create(User_Memory* user_memory, char* user_name, size_t name_length){
+  user_memory_management(user_memory);
+  // find an empty user slot to use
+  do {
+    user_memory->last_created = (user_memory->last_created + 1) % user_memory->allocation_total;
+  } while(user_memory->users[user_memory->last_created].trash == FALSE);
+  User* user = user_memory->users + user_memory->last_created;
+  user_memory->allocation_used += 1;
+
+  // zero everything there
+  memset((void*) user, 0, sizeof(User));
+  user->trash = FALSE; 
+  user->name_length = name_length;
+
+  char* name = (char*) malloc(name_length+1);
+  memcpy(name, user_name, name_length);
+  name[name_length] = '\0';
+  hash_table_insert(user_memory->hashtable, name, (void*) user);
+  user->name = name;
+
+  return user;
+}
+
+
+User* user_get(User_Memory* user_memory, char* user_name, int user_name_length){
+  // use the hash table to find a pointer to the user based on the string given
+  // return NULL if does not exist and needs to be created
+  char name[128]; // TODO
+  memcpy(name, user_name, user_name_length);
+  name[user_name_length] = '\0';
+  User* user = (User*) hash_table_get(user_memory->hashtable, name);
+  return user;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// return NULL, result_length=0 
+char* string_strip(int* result_length, char* str, int str_length){
+  // look at the front, cut off bad characters
+  char* result = str; 
+  *result_length = str_length;
+  if (str_length <= 0){ // a line like ': value', nothing before the split
+    *result_length = 0;
+    return NULL;
+  }
+  while (isalnum(result[0]) == 0){
+    ++result;
+    *result_length -= 1;
+    if (*result_length == 0){
+      return NULL;
+    }
+  }
+
+  // seek to the end, search backwards to cut off bad characters
+  char* end = result + *result_length - 1;
+  while (isalnum(end[0]) == 0){
+    --end;
+    *result_length -= 1;
+    if (*result_length == 0){
+      return NULL;
+    }
+  }
+
+  return result;
+}
+
+
+// scrub through tasks, remove any that you expected to see but did not
+void editor_tasks_cleanup(Task_Memory* task_memory){
+  Task* tasks = task_memory->tasks;
+  size_t destroyed = 0;
+  for (size_t i=0; i<task_memory->allocation_total; ++i){
+    if (tasks[i].trash == FALSE){ // if node is NOT trash
+      if (tasks[i].mode_edit == TRUE){
+
+        // if we did not visit the node this time parsing the text
+        if (task_memory->editor_visited[i] == FALSE){
+          task_destroy(task_memory, tasks+i);
+          destroyed += 1;
+        }
+      }
+    }
+  }
+
+  // the parse still found them by name, so other tasks can list them as prereqs. parses of only the edited blocks
+  // won't look at those tasks again, and the slot may be reused by a new task
+  if (destroyed > 0){
+    for (size_t i=0; i<task_memory->allocation_total; ++i){
+      if (tasks[i].trash == FALSE){
+        size_t kept = 0;
+        for (size_t p=0; p<tasks[i].prereq_qty; ++p){
+          if (tasks[i].prereqs[p]->trash == FALSE){
+            tasks[i].prereqs[kept] = tasks[i].prereqs[p];
+            kept += 1;
+          }
+        }
+        tasks[i].prereq_qty = kept;
+      }
+    }
+  }
+}
+
+
+// remove a user with zero assigned tasks (user->task_qty = 0)
+void editor_user_cleanup(User_Memory* user_memory, User* user){
+  if(user->trash == FALSE){
+    if (user->task_qty == 0){
+
+      user->trash = TRUE;
+      if (user_memory->allocation_used > 0){
+        user_memory->allocation_used -= 1;
+      }
+      printf("REMOVING users[%ld].name=%s..\n", user - user_memory->users, user->name);
+
+      hash_table_remove(user_memory->hashtable, user->name);
+    }
+  }
+}
+
+
+// scrub through users, remove any that have zero assigned tasks
+void editor_users_cleanup(User_Memory* user_memory){
+  for (size_t i=0; i<user_memory->allocation_total; ++i){
+    editor_user_cleanup(user_memory, user_memory->users + i);
+  }
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// a record is a flags byte, pos, removed and inserted as varints, the removed bytes, the inserted bytes, and the
+// record's length in 4 bytes, so they can be walked either way
+Text_Journal* editor_journal_create(size_t size){
+  Text_Journal* j = (Text_Journal*) malloc(sizeof(Text_Journal));
+  j->bytes = (uint8_t*) malloc(size);
+  j->size = size;
+  j->tail = 0;
+  j->head = 0;
+  j->redo_end = 0;
+  j->group_open = FALSE;
+  j->group_dropped = FALSE;
+  j->replaying = FALSE;
+  return j;
+}
+
+void editor_journal_destroy(Text_Journal* j){
+  free(j->bytes);
+  free(j);
+}
+
+// forget every record, the text they were about is gone
+void editor_journal_reset(Text_Journal* j){
+  if (j == NULL){
+    return;
+  }
+  j->tail = 0;
+  j->head = 0;
+  j->redo_end = 0;
+  j->group_open = FALSE;
+  j->group_dropped = FALSE;
+}
+
+// a frame's edits are one group, the next edit starts another
+void editor_journal_group_end(Text_Journal* j){
+  if (j != NULL){
+    j->group_open = FALSE;
+    j->group_dropped = FALSE;
+  }
+}
+
+
+// copy qty bytes into or out of the ring at offset, wrapping around its end
+void editor_journal_put(Text_Journal* j, size_t offset, const void* data, size_t qty){
+  if (qty == 0){
+    return;
+  }
+  size_t at = offset % j->size;
+  size_t first = (j->size - at < qty) ? j->size - at : qty;
+  memcpy(j->bytes + at, data, first);
+  memcpy(j->bytes, (const uint8_t*) data + first, qty - first);
+}
+
+void editor_journal_get(Text_Journal* j, size_t offset, void* data, size_t qty){
+  if (qty == 0){
+    return;
+  }
+  size_t at = offset % j->size;
+  size_t first = (j->size - at < qty) ? j->size - at : qty;
+  memcpy(data, j->bytes + at, first);
+  memcpy((uint8_t*) data + first, j->bytes, qty - first);
+}
+
+
+// 7 bits a byte, low ones first, the high bit set on all but the last. most edits need a byte or two for each number
+size_t editor_journal_varint(uint8_t* out, uint32_t value){
+  size_t qty = 0;
+  do {
+    out[qty] = value & 0x7F;
+    value >>= 7;
+    if (value != 0){
+      out[qty] |= 0x80;
+    }
+    qty += 1;
+  } while (value != 0);
+  return qty;
+}
+
+uint32_t editor_journal_varint_read(Text_Journal* j, size_t* offset){
+  uint32_t value = 0;
+  int shift = 0;
+  uint8_t byte;
+  do {
+    byte = j->bytes[*offset % j->size];
+    *offset += 1;
+    value |= (uint32_t) (byte & 0x7F) << shift;
+    shift += 7;
+  } while ((byte & 0x80) != 0);
+  return value;
+}
+
+
+// the record at start
+void editor_journal_read(Text_Journal* j, size_t start, Text_Journal_Record* record){
+  size_t offset = start;
+  record->start = start;
+  record->flags = j->bytes[offset % j->size];
+  offset += 1;
+  record->pos = editor_journal_varint_read(j, &offset);
+  record->removed = editor_journal_varint_read(j, &offset);
+  record->inserted = editor_journal_varint_read(j, &offset);
+  record->removed_at = offset;
+  record->inserted_at = offset + record->removed;
+  record->end = record->inserted_at + record->inserted + 4;
+}
+
+// the record that ends at end
+void editor_journal_read_back(Text_Journal* j, size_t end, Text_Journal_Record* record){
+  uint32_t length;
+  editor_journal_get(j, end - 4, &length, 4);
+  editor_journal_read(j, end - length, record);
+}
+
+
+// drop the oldest group, to make room for new ones
+void editor_journal_drop_group(Text_Journal* j){
+  Text_Journal_Record record;
+  do {
+    editor_journal_read(j, j->tail, &record);
+    j->tail = record.end;
+  } while ((j->tail != j->head) && ((j->bytes[j->tail % j->size] & JOURNAL_GROUP_START) == 0));
+}
+
+
+// add a record of the removed bytes at pos being replaced by inserted new ones. it joins the open group if there is
+// one. anything undone before can't be redone after a new edit
+void editor_journal_write(Text_Journal* j, int pos, const char* removed_bytes, int removed, const char* inserted_bytes, int inserted){
+  j->redo_end = j->head;
+  if (j->group_dropped == TRUE){
+    return;
+  }
+  uint8_t header[16];
+  size_t header_length = 1;
+  header_length += editor_journal_varint(header + header_length, pos);
+  header_length += editor_journal_varint(header + header_length, removed);
+  header_length += editor_journal_varint(header + header_length, inserted);
+  uint32_t length = header_length + removed + inserted + 4;
+
+  // the oldest groups make room. if that isn't enough without dropping the open one, the whole group is too big to
+  // keep. nothing before it can be undone either, it would be undone onto the wrong text
+  uint8_t fits = (length <= j->size);
+  while ((fits == TRUE) && (j->head + length - j->tail > j->size)){
+    editor_journal_drop_group(j);
+    fits = (j->group_open == FALSE) || (j->tail != j->head);
+  }
+  if (fits == FALSE){
+    printf("[WARNING] EDIT IS TOO BIG FOR THE UNDO HISTORY, CLEARING IT\n");
+    editor_journal_reset(j);
+    j->group_dropped = TRUE;
+    return;
+  }
+
+  header[0] = (j->group_open == FALSE) ? JOURNAL_GROUP_START : 0;
+  editor_journal_put(j, j->head, header, header_length);
+  editor_journal_put(j, j->head + header_length, removed_bytes, removed);
+  editor_journal_put(j, j->head + header_length + removed, inserted_bytes, inserted);
+  editor_journal_put(j, j->head + length - 4, &length, 4);
+  j->head += length;
+  j->redo_end = j->head;
+  j->group_open = TRUE;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// a buffer with room for text_max bytes and lines_max lines to start with, it grows as needed
+Text_Buffer* editor_buffer_create(size_t text_max, size_t lines_max){
+  Text_Buffer* tb = (Text_Buffer*) malloc(sizeof(Text_Buffer));
+
+  tb->text = (char*) malloc(text_max * sizeof(char));
+  memset(tb->text, 0, text_max);
+  tb->length = 0;
+  tb->gap_start = 0;
+  tb->gap_length = text_max;
+  tb->text_max = text_max;
+
+  tb->lines = 1; // empty text is still one line
+  tb->lines_max = lines_max;
+  tb->line_task = (Task**) calloc(lines_max, sizeof( *(tb->line_task)));
+  tb->line_length = (int*) calloc(lines_max, sizeof(*tb->line_length));
+  tb->line_tree = (int*) calloc(lines_max + 1, sizeof(*tb->line_tree));
+
+  memset(&tb->scan, 0, sizeof(tb->scan));
+  tb->blocks = NULL;
+  tb->block_qty = 0;
+  tb->block_max = 0;
+  tb->parsed_length = 0;
+  tb->parsed_lines = 0;
+  tb->parsed_repeats = FALSE;
+  tb->symbols = NULL;
+  tb->symbol_qty = 0;
+  tb->symbol_max = 0;
+  tb->edit_all = TRUE;
+  tb->edit_pending = FALSE;
+  tb->journal = NULL;
+
+  return tb;
+}
+
+Text_Buffer* editor_buffer_init(){
+  return editor_buffer_create(EDITOR_BUFFER_LENGTH, EDITOR_LINES_MAX);
+}
+
+void editor_buffer_destroy(Text_Buffer* tb){
+  free(tb->text);
+  free(tb->line_length);
+  free(tb->line_task);
+  free(tb->line_tree);
+  free(tb->blocks);
+  free(tb->symbols);
+  scan_free(&tb->scan);
+  if (tb->journal != NULL){
+    editor_journal_destroy(tb->journal);
+  }
+  free(tb);
+}
+
+
+// room for text_qty bytes of text and lines_qty lines. at least doubles what it grows, so growing is amortized O(1)
+void editor_buffer_reserve(Text_Buffer* tb, int text_qty, int lines_qty){
+  if (text_qty > tb->text_max){
+    int text_max = 2 * tb->text_max;
+    if (text_max < text_qty){
+      text_max = text_qty;
+    }
+    tb->text = (char*) realloc(tb->text, text_max * sizeof(char));
+
+    // the text after the gap goes to the new end, the gap gets the new room
+    int after = tb->length - tb->gap_start;
+    memmove(tb->text + text_max - after, tb->text + tb->gap_start + tb->gap_length, after);
+    tb->gap_length = text_max - tb->length;
+    tb->text_max = text_max;
+  }
+  if (lines_qty > tb->lines_max){
+    int lines_max = 2 * tb->lines_max;
+    if (lines_max < lines_qty){
+      lines_max = lines_qty;
+    }
+    tb->line_task = (Task**) realloc(tb->line_task, lines_max * sizeof(*tb->line_task));
+    tb->line_length = (int*) realloc(tb->line_length, lines_max * sizeof(*tb->line_length));
+    tb->line_tree = (int*) realloc(tb->line_tree, (lines_max + 1) * sizeof(*tb->line_tree));
+    for (int i=tb->lines_max; i<lines_max; ++i){
+      tb->line_task[i] = NULL;
+      tb->line_length[i] = 0;
+      tb->line_tree[i + 1] = 0;
+    }
+    tb->lines_max = lines_max;
+  }
+}
+
+
+// put the gap at pos, moving the text in between across it
+void editor_buffer_gap_move(Text_Buffer* tb, int pos){
+  if (pos < tb->gap_start){
+    memmove(tb->text + pos + tb->gap_length, tb->text + pos, tb->gap_start - pos);
+  }
+  else if (pos > tb->gap_start){
+    memmove(tb->text + tb->gap_start, tb->text + tb->gap_start + tb->gap_length, pos - tb->gap_start);
+  }
+  tb->gap_start = pos;
+}
+
+
+// the text in [start, end) as one run of bytes. if the gap is in the middle of it, it moves to the closer end
+char* editor_buffer_view(Text_Buffer* tb, int start, int end){
+  if ((tb->gap_start > start) && (tb->gap_start < end)){
+    if (tb->gap_start - start < end - tb->gap_start){
+      editor_buffer_gap_move(tb, start);
+    }
+    else{
+      editor_buffer_gap_move(tb, end);
+    }
+  }
+  if (tb->gap_start <= start){
+    return tb->text + tb->gap_length + start;
+  }
+  return tb->text + start;
+}
+
+
+// where line starts in the text. line can be tb->lines, for the end of the text
+int editor_line_start(Text_Buffer* tb, int line){
+  int pos = 0;
+  for (int i=line; i>0; i -= i & -i){
+    pos += tb->line_tree[i];
+  }
+  return pos;
+}
+
+
+// line_tree is a Fenwick tree over line_length: line_tree[i] is the sum of the lengths of lines [i - (i & -i), i), so
+// where a line starts and which line a position is on are O(log lines). the lines before line kept their lengths, so
+// only the entries past it are rebuilt, in O(lines - line + log lines)
+void editor_lines_index(Text_Buffer* tb, int line){
+  // where each line after line ends, then take away where each entry's range starts
+  int* tree = tb->line_tree;
+  int pos = editor_line_start(tb, line);
+  for (int i=line+1; i<=tb->lines; ++i){
+    pos += tb->line_length[i - 1];
+    tree[i] = pos;
+  }
+  for (int i=tb->lines; i>line; --i){
+    int start = i - (i & -i);
+    tree[i] -= (start > line) ? tree[start] : editor_line_start(tb, start);
+  }
+}
+
+
+// the line pos is on, and in *col how far into it. the end of the text is line tb->lines
+int editor_line_find(Text_Buffer* tb, int pos, int* col){
+  int step = 1;
+  while (2 * step <= tb->lines){
+    step *= 2;
+  }
+  int line = 0;
+  for (; step>0; step/=2){
+    if ((line + step <= tb->lines) && (tb->line_tree[line + step] <= pos)){
+      line += step;
+      pos -= tb->line_tree[line];
+    }
+  }
+  *col = pos;
+  return line;
+}
+
+
+// like editor_line_find(), but the end of the text is on the last line if that one has no '\n' yet
+int editor_line_locate(Text_Buffer* tb, int pos, int* col){
+  int line = editor_line_find(tb, pos, col);
+  if ((line == tb->lines) && (line > 0)){
+    if ((tb->length == 0) || (*editor_buffer_view(tb, tb->length - 1, tb->length) != '\n')){
+      line -= 1;
+      *col = tb->line_length[line];
+    }
+  }
+  return line;
+}
+
+
+void editor_line_length_add(Text_Buffer* tb, int line, int delta){
+  tb->line_length[line] += delta;
+  for (int i=line+1; i<=tb->lines; i += i & -i){
+    tb->line_tree[i] += delta;
+  }
+}
+
+
+// an empty line after the last one
+void editor_line_append(Text_Buffer* tb){
+  editor_buffer_reserve(tb, 0, tb->lines + 1);
+  int n = tb->lines + 1;
+  tb->line_length[n - 1] = 0;
+  tb->line_tree[n] = editor_line_start(tb, n - 1) - editor_line_start(tb, n - (n & -n));
+  tb->lines = n;
+}
+
+
+// lines [line, tb->lines) move down by shift, or up when it's negative. the caller fills in the lines that opened up,
+// then calls editor_lines_index() from the first line it changed. line_task is left to the parser, it moves those itself
+void editor_lines_shift(Text_Buffer* tb, int line, int shift){
+  editor_buffer_reserve(tb, 0, tb->lines + shift + 1);
+  memmove(tb->line_length + line + shift, tb->line_length + line, (tb->lines - line) * sizeof(*tb->line_length));
+  for (int i=tb->lines+shift; i<tb->lines; ++i){
+    tb->line_length[i] = 0;
+  }
+  tb->lines += shift;
+}
+
+
+// the text ends with a '\n' now, so there's no line after it. unless it's the only one
+void editor_line_drop_empty(Text_Buffer* tb){
+  if ((tb->lines > 1) && (tb->line_length[tb->lines - 1] == 0)){
+    tb->lines -= 1;
+  }
+}
+
+
+// the text from col_first on line first to col_last on line last is about to be replaced by the qty bytes. lines after
+// last move over by the '\n's that come and go, and the lines from first on aren't indexed again, so several of these
+// from the back of the text can share one editor_lines_index() call. last has to be below tb->lines, see
+// editor_line_append()
+void editor_lines_splice(Text_Buffer* tb, int first, int col_first, int last, int col_last, const char* bytes, int qty){
+  int newlines = 0;
+  for (const char* c=memchr(bytes, (int) '\n', qty); c!=NULL; c=memchr(c + 1, (int) '\n', bytes + qty - (c + 1))){
+    newlines += 1;
+  }
+  int rest = tb->line_length[last] - col_last;
+  editor_lines_shift(tb, last + 1, newlines - (last - first));
+  const char* segment = bytes;
+  for (int l=first; l<first+newlines; ++l){
+    const char* newline = memchr(segment, (int) '\n', bytes + qty - segment);
+    tb->line_length[l] = (newline + 1 - segment) + ((l == first) ? col_first : 0);
+    segment = newline + 1;
+  }
+  tb->line_length[first + newlines] = (bytes + qty - segment) + rest + ((newlines == 0) ? col_first : 0);
+}
+
+
+// update the lines for qty bytes about to be inserted at pos. typing within a line is O(log lines), a '\n' moves the
+// lines after it, O(lines after pos)
+void editor_lines_insert(Text_Buffer* tb, int pos, const char* bytes, int qty){
+  int col;
+  int line = editor_line_locate(tb, pos, &col);
+  if (line == tb->lines){
+    editor_line_append(tb);
+  }
+  if (memchr(bytes, (int) '\n', qty) == NULL){
+    editor_line_length_add(tb, line, qty);
+    return;
+  }
+
+  // split the line at each '\n'
+  editor_lines_splice(tb, line, col, line, col, bytes, qty);
+  editor_line_drop_empty(tb);
+  editor_lines_index(tb, line);
+}
+
+
+// update the lines for the qty bytes at pos about to be deleted
+void editor_lines_delete(Text_Buffer* tb, int pos, int qty){
+  if (qty <= 0){
+    return;
+  }
+  int col_first;
+  int col_last;
+  int first = editor_line_locate(tb, pos, &col_first);
+  int last = editor_line_locate(tb, pos + qty, &col_last);
+  if (first == last){
+    editor_line_length_add(tb, first, -qty);
+    if ((first == tb->lines - 1) && (tb->line_length[first] == 0)){
+      editor_line_drop_empty(tb);
+    }
+    return;
+  }
+
+  // the lines run together
+  if (last == tb->lines){
+    editor_line_append(tb);
+  }
+  editor_lines_splice(tb, first, col_first, last, col_last, "", 0);
+  editor_line_drop_empty(tb);
+  editor_lines_index(tb, first);
+}
+
+
+// parse text_buffer->text for endlines.
+// store result in text_buffer->lines and text_buffer->line_lengths[]
+void editor_find_line_lengths(Text_Buffer* tb){
+  // the text before the gap and after it are scanned apart so the gap can stay where it is. a line can run across it
+  int piece_start[2] = {0, tb->gap_start};
+  int piece_end[2] = {tb->gap_start, tb->length};
+  int run_on = 0;
+  tb->lines = 0;
+  for (int p=0; p<2; ++p){
+    char* text = editor_buffer_view(tb, piece_start[p], piece_end[p]) - piece_start[p];
+    scan_text(&tb->scan, text, piece_start[p], piece_end[p]);
+    editor_buffer_reserve(tb, 0, tb->lines + tb->scan.line_qty + 1);
+    for (size_t l=0; l<tb->scan.line_qty; ++l){
+      Scan_Line* line = tb->scan.lines + l;
+      if (line->start + line->length < piece_end[p]){
+        tb->line_length[tb->lines] = run_on + line->length + 1; // counts the '\n'
+        tb->lines += 1;
+        run_on = 0;
+      }
+      else{
+        run_on += line->length;
+      }
+    }
+  }
+
+  // the last line, if it has no '\n'. empty text is still one line
+  if ((run_on > 0) || (tb->lines == 0)){
+    tb->line_length[tb->lines] = run_on;
+    tb->lines += 1;
+  }
+
+  for(int i=tb->lines; i<tb->lines_max; ++i){
+    tb->line_length[i] = 0;
+  }
+  editor_lines_index(tb, 0);
+}
+
+
+// journal the removed bytes at pos about to be replaced by inserted new ones, if the buffer keeps a journal and this
+// isn't an undo or redo. shift is how far edits made before it will have moved pos by then
+void editor_journal_record(Text_Buffer* tb, int pos, int shift, int removed, const char* inserted_bytes, int inserted){
+  if ((tb->journal == NULL) || (tb->journal->replaying == TRUE) || (removed + inserted == 0)){
+    return;
+  }
+  char* removed_bytes = editor_buffer_view(tb, pos, pos + removed);
+  editor_journal_write(tb->journal, pos + shift, removed_bytes, removed, inserted_bytes, inserted);
+}
+
+
+// note that the bytes [pos, pos + removed) were just replaced by inserted new ones, so the next parse can skip the rest
+void editor_buffer_edited(Text_Buffer* text_buffer, int pos, int removed, int inserted){
+  if (text_buffer->edit_pending == FALSE){
+    text_buffer->edit_pending = TRUE;
+    text_buffer->edit_start = pos;
+    text_buffer->edit_end = pos;
+    text_buffer->edit_end_parsed = pos;
+  }
+  if (pos < text_buffer->edit_start){
+    text_buffer->edit_start = pos;
+  }
+  if (pos + removed > text_buffer->edit_end){
+    text_buffer->edit_end_parsed += pos + removed - text_buffer->edit_end;
+    text_buffer->edit_end = pos + removed;
+  }
+  text_buffer->edit_end += inserted - removed;
+}
+
+
+void editor_buffer_insert(Text_Buffer* tb, int pos, const char* bytes, int qty){
+  editor_journal_record(tb, pos, 0, 0, bytes, qty);
+  editor_lines_insert(tb, pos, bytes, qty);
+  editor_buffer_reserve(tb, tb->length + qty, 0);
+  editor_buffer_gap_move(tb, pos);
+  memcpy(tb->text + pos, bytes, qty);
+  tb->gap_start += qty;
+  tb->gap_length -= qty;
+  tb->length += qty;
+  editor_buffer_edited(tb, pos, 0, qty);
+}
+
+
+void editor_buffer_delete(Text_Buffer* tb, int pos, int qty){
+  editor_journal_record(tb, pos, 0, qty, NULL, 0);
+  editor_lines_delete(tb, pos, qty);
+  editor_buffer_gap_move(tb, pos);
+  tb->gap_length += qty;
+  tb->length -= qty;
+  editor_buffer_edited(tb, pos, qty, 0);
+}
+
+
+// apply qty edits, sorted by pos and not overlapping, in one pass over the text they span. much cheaper than one
+// editor_buffer_insert() or editor_buffer_delete() each when they're far apart, each of those moves the gap
+void editor_buffer_apply(Text_Buffer* tb, Text_Edit* edits, size_t qty, const char* bytes){
+  if (qty == 0){
+    return;
+  }
+  int span_start = edits[0].pos;
+  int span_end = edits[qty - 1].pos + edits[qty - 1].removed;
+  int inserted = 0;
+  int removed = 0;
+  uint8_t newlines = FALSE;
+  for (size_t i=0; i<qty; ++i){
+    Text_Edit* edit = edits + i;
+    inserted += edit->inserted;
+    removed += edit->removed;
+    if (memchr(bytes + edit->bytes, (int) '\n', edit->inserted) != NULL){
+      newlines = TRUE;
+    }
+    if ((edit->removed > 0) && (memchr(editor_buffer_view(tb, edit->pos, edit->pos + edit->removed), (int) '\n', edit->removed) != NULL)){
+      newlines = TRUE;
+    }
+  }
+
+  // the journal takes them one after the other, each where it lands once the ones before it are made
+  int shift = 0;
+  for (size_t i=0; i<qty; ++i){
+    Text_Edit* edit = edits + i;
+    editor_journal_record(tb, edit->pos, shift, edit->removed, bytes + edit->bytes, edit->inserted);
+    shift += edit->inserted - edit->removed;
+  }
+
+  // edits within lines only change their lengths, in O(log lines) each. done from the back while the text is still the
+  // old one, so the positions before stay put. a last line they empty goes once they're all done, the ones before
+  // still find the end of the text on it
+  if (newlines == FALSE){
+    for (size_t i=qty; i>0; --i){
+      Text_Edit* edit = edits + i - 1;
+      if (edit->inserted == edit->removed){
+        continue;
+      }
+      int col;
+      int line = editor_line_locate(tb, edit->pos, &col);
+      if (line == tb->lines){
+        editor_line_append(tb);
+      }
+      editor_line_length_add(tb, line, edit->inserted - edit->removed);
+    }
+    editor_line_drop_empty(tb);
+  }
+
+  // with '\n's, the lines of each edit are spliced, from the back so the lines before it keep their numbers. they're all
+  // found first, the index isn't kept up until the end. then it's rebuilt once, past the first line they touched
+  else{
+    int* found = (int*) malloc(4 * qty * sizeof(int));
+    for (size_t i=0; i<qty; ++i){
+      found[4*i] = editor_line_locate(tb, edits[i].pos, found + 4*i + 1);
+      found[4*i + 2] = editor_line_locate(tb, edits[i].pos + edits[i].removed, found + 4*i + 3);
+    }
+    if (found[4*qty - 2] == tb->lines){
+      editor_line_append(tb);
+    }
+    for (size_t i=qty; i>0; --i){
+      Text_Edit* edit = edits + i - 1;
+      int* lines = found + 4*(i - 1);
+      editor_lines_splice(tb, lines[0], lines[1], lines[2], lines[3], bytes + edit->bytes, edit->inserted);
+    }
+    editor_line_drop_empty(tb);
+    editor_lines_index(tb, found[0]);
+    free(found);
+  }
+
+  // the gap goes to the end of the span, then the span is written again from the back into the end of the gap
+  editor_buffer_reserve(tb, tb->length + inserted, 0);
+  editor_buffer_gap_move(tb, span_end);
+  char* write = tb->text + tb->gap_start + tb->gap_length;
+  int read = span_end;
+  for (size_t i=qty; i>0; --i){
+    Text_Edit* edit = edits + i - 1;
+    int kept = read - (edit->pos + edit->removed);
+    write -= kept;
+    memmove(write, tb->text + edit->pos + edit->removed, kept);
+    write -= edit->inserted;
+    memcpy(write, bytes + edit->bytes, edit->inserted);
+    read = edit->pos;
+  }
+  tb->length += inserted - removed;
+  tb->gap_start = span_start;
+  tb->gap_length = tb->text_max - tb->length;
+  editor_buffer_edited(tb, span_start, span_end - span_start, span_end - span_start + inserted - removed);
+}
+
+
+// make the text the length bytes of text, as one edit of what differs between them. what stays the same isn't moved,
+// and only the difference is journaled
+void editor_buffer_replace(Text_Buffer* tb, const char* text, int length){
+  char* old = editor_buffer_view(tb, 0, tb->length);
+  int shorter = (length < tb->length) ? length : tb->length;
+  int prefix = 0;
+  while ((prefix < shorter) && (old[prefix] == text[prefix])){
+    ++prefix;
+  }
+  int suffix = 0;
+  while ((suffix < shorter - prefix) && (old[tb->length - 1 - suffix] == text[length - 1 - suffix])){
+    ++suffix;
+  }
+  Text_Edit edit;
+  edit.pos = prefix;
+  edit.removed = tb->length - prefix - suffix;
+  edit.inserted = length - prefix - suffix;
+  edit.bytes = prefix;
+  if ((edit.removed > 0) || (edit.inserted > 0)){
+    editor_buffer_apply(tb, &edit, 1, text);
+  }
+}
+
+
+// empty the buffer to write all of it again. the gap takes everything, writers fill it from tb->text on and then
+// call editor_buffer_written(), which finds the lines again. there's nothing to undo back to after that
+void editor_buffer_clear(Text_Buffer* tb){
+  editor_journal_reset(tb->journal);
+  tb->length = 0;
+  tb->gap_start = 0;
+  tb->gap_length = tb->text_max;
+  tb->edit_all = TRUE;
+}
+
+void editor_buffer_written(Text_Buffer* tb, int length){
+  tb->length = length;
+  tb->gap_start = length;
+  tb->gap_length = tb->text_max - length;
+  editor_find_line_lengths(tb);
+}
+
+
+// replace the text with everything left in fd
+void editor_buffer_read(Text_Buffer* tb, FILE* fd){
+  editor_buffer_clear(tb);
+  size_t got;
+  do {
+    editor_buffer_reserve(tb, tb->length + 4096, 0);
+    got = fread(tb->text + tb->length, 1, tb->text_max - tb->length, fd);
+    tb->length += got;
+    tb->gap_start = tb->length;
+    tb->gap_length = tb->text_max - tb->length;
+  } while (got > 0);
+  editor_buffer_written(tb, tb->length);
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// add a block to the end of the buffer's list
+void editor_block_push(Text_Buffer* text_buffer, size_t task, int start, int line){
+  if (text_buffer->block_qty >= text_buffer->block_max){
+    text_buffer->block_max = 2 * text_buffer->block_max + 16;
+    text_buffer->blocks = (Text_Block*) realloc(text_buffer->blocks, text_buffer->block_max * sizeof(Text_Block));
+  }
+  Text_Block* block = text_buffer->blocks + text_buffer->block_qty;
+  block->task = task;
+  block->start = start;
+  block->line = line;
+  text_buffer->block_qty += 1;
+}
+
+
+// where the list of places the entity of a symbol of type is named starts
+size_t* editor_symbol_head(uint8_t type, void* entity){
+  if (type == TEXTCURSOR_ENTITY_USER){
+    return &((User*) entity)->editor_symbol;
+  }
+  return &((Task*) entity)->editor_symbol;
+}
+
+
+// the first of the places entity is named, SIZE_MAX if there are none. the head may be left over from a text parsed
+// before, or from a task or user that used the slot before. it only counts if it names entity and nothing comes before
+size_t editor_symbol_first(Text_Buffer* text_buffer, uint8_t type, void* entity){
+  size_t head = *editor_symbol_head(type, entity);
+  if ((head < text_buffer->symbol_qty) && (text_buffer->symbols[head].entity == entity) && (text_buffer->symbols[head].prev == SIZE_MAX)){
+    return head;
+  }
+  return SIZE_MAX;
+}
+
+
+// add a name at [start, start + length) to the end of the buffer's list, they come in text order. and to the front of
+// the places its entity is named
+void editor_symbol_push(Text_Buffer* text_buffer, uint8_t type, void* entity, int start, int length){
+  if (text_buffer->symbol_qty >= text_buffer->symbol_max){
+    text_buffer->symbol_max = 2 * text_buffer->symbol_max + 64;
+    text_buffer->symbols = (Text_Symbol*) realloc(text_buffer->symbols, text_buffer->symbol_max * sizeof(Text_Symbol));
+  }
+  Text_Symbol* symbol = text_buffer->symbols + text_buffer->symbol_qty;
+  symbol->type = type;
+  symbol->entity = entity;
+  symbol->start = start;
+  symbol->length = length;
+  symbol->prev = SIZE_MAX;
+  symbol->next = editor_symbol_first(text_buffer, type, entity);
+  if (symbol->next != SIZE_MAX){
+    text_buffer->symbols[symbol->next].prev = text_buffer->symbol_qty;
+  }
+  *editor_symbol_head(type, entity) = text_buffer->symbol_qty;
+  text_buffer->symbol_qty += 1;
+}
+
+
+// take the name at s off the places its entity is named, it's about to go
+void editor_symbol_unlink(Text_Buffer* text_buffer, size_t s){
+  Text_Symbol* symbol = text_buffer->symbols + s;
+  if (symbol->prev != SIZE_MAX){
+    text_buffer->symbols[symbol->prev].next = symbol->next;
+  }
+  else{
+    *editor_symbol_head(symbol->type, symbol->entity) = symbol->next;
+  }
+  if (symbol->next != SIZE_MAX){
+    text_buffer->symbols[symbol->next].prev = symbol->prev;
+  }
+  symbol->entity = NULL;
+}
+
+
+// first name starting at or after pos
+size_t editor_symbol_find(Text_Buffer* text_buffer, int pos){
+  size_t low = 0;
+  size_t high = text_buffer->symbol_qty;
+  while (low < high){
+    size_t middle = (low + high) / 2;
+    if (text_buffer->symbols[middle].start < pos){
+      low = middle + 1;
+    }
+    else{
+      high = middle;
+    }
+  }
+  return low;
+}
+
+
+// the name pos is on, or right after the end of. NULL if there isn't one
+Text_Symbol* editor_symbol_at(Text_Buffer* text_buffer, int pos){
+  size_t s = editor_symbol_find(text_buffer, pos + 1);
+  if (s == 0){
+    return NULL;
+  }
+  Text_Symbol* symbol = text_buffer->symbols + s - 1;
+  if (pos > symbol->start + symbol->length){
+    return NULL;
+  }
+  return symbol;
+}
+
+
+// PASS 1 over the lines in text_buffer->scan. creates tasks as they are named, marks them as visited, fills in
+// line_task from line on, and adds a block for each '{' line. returns how many lines there were
+int editor_parse_task_detect(Task_Memory* task_memory, Text_Buffer* text_buffer, int line){
+  printf("[STATUS] PASS 1 editor_parse_task_detect()\n");
+  Scan_Index* scan = &text_buffer->scan;
+  editor_buffer_reserve(text_buffer, 0, line + scan->line_qty + 1);
+  Task* task = NULL;
+
+  // text before the first task gets a block of its own
+  if ((scan->line_qty > 0) && ((scan->lines[0].marks & SCAN_MARK_OPEN) == 0)){
+    editor_block_push(text_buffer, SIZE_MAX, scan->lines[0].start, line);
+  }
+
+  for (size_t l=0; l<scan->line_qty; ++l){
+    Scan_Line* scan_line = scan->lines + l;
+    if ((scan_line->marks & SCAN_MARK_OPEN) != 0){
+      // TODO check, prevent duplicate task names
+      size_t block_task = SIZE_MAX;
+      int task_name_length;
+      char* task_name = string_strip(&task_name_length, scan->text + scan_line->start, scan_line->length);
+      if (task_name_length > 0){
+        printf("detected task: '%.*s'\n", task_name_length, task_name);
+
+        // now get a pointer to the task
+        task = task_get(task_memory, task_name, task_name_length);
+        if (task == NULL){
+          task = task_create(task_memory, task_name, task_name_length); // TODO is create the right action? maybe parse and then decide? 
+          printf("created task. allocations: %ld of %ld\n", task_memory->allocation_used, task_memory->allocation_total);
+        }
+
+        // mark task as visited
+        task_memory->editor_visited[task - task_memory->tasks] = TRUE;
+        block_task = task - task_memory->tasks;
+      }
+      editor_block_push(text_buffer, block_task, scan_line->start, line + l);
+    }
+
+    text_buffer->line_task[line + l] = task;
+  }
+  return scan->line_qty;
+}
+
+
+// atoi() for a value in the text buffer. it isn't '\0' terminated, what comes after the text can be anything
+int editor_parse_int(char* value_str, int value_str_length){
+  char number[32];
+  snprintf(number, sizeof(number), "%.*s", value_str_length, value_str);
+  return atoi(number);
+}
+
+
+uint64_t editor_parse_date(char* value_str, int value_str_length){
+  // a terminated copy, strtol() doesn't stop at the end of the value. zeroed with a spare byte, a malformed date like
+  // "2023--28" can have the day read from one past the end
+  char date[33] = {0};
+  value_str_length = snprintf(date, sizeof(date) - 1, "%.*s", value_str_length, value_str);
+  if (value_str_length >= (int) sizeof(date) - 1){
+    value_str_length = sizeof(date) - 2;
+  }
+  value_str = date;
+
+  // get the current time to initialize some values of timeinfo with time zone and stuff
+  time_t now; 
+  time(&now);
+  struct tm* timeinfo = gmtime(&now);
+
+  char* line_end = value_str + value_str_length;
+
+  // separate year from month
+  char* split1 = memchr(value_str, (int) '-', value_str_length);
+  if (split1 != NULL){
+    timeinfo->tm_year = strtol(value_str, &split1, 10);
+
+    // separate month from day
+    char* split2 = memchr(split1+1, (int) '-', value_str_length - (split1 - value_str) - 1);
+    if (split2 != NULL){
+      timeinfo->tm_mon = strtol(split1+1, &split2, 10);
+      timeinfo->tm_mday = strtol(split2+1, &line_end, 10);
+    }
+    // can't find a day, use start of the month as default
+    else{
+      timeinfo->tm_mon = strtol(split1+1, &line_end, 10);
+      timeinfo->tm_mday = 1;
+    }
+  }
+
+  // can't find a month (or day), use start as default
+  else{
+    timeinfo->tm_year = strtol(value_str, &line_end, 10);
+    timeinfo->tm_mon = 1;
+    timeinfo->tm_mday = 1;
+  }
+
+  // now convert that into epoch time..
+  timeinfo->tm_year -= 1900; // years are 1900-indexed
+  timeinfo->tm_mon -= 1; // months are zero-indexed
+  timeinfo->tm_sec = 0;
+  timeinfo->tm_min = 0;
+  timeinfo->tm_hour = 0;
+  time_t date_epoch = mktime(timeinfo);
+  assert(date_epoch != -1);
+
+  // date_epoch is seconds since epoch. divide to get days since epoch
+  uint64_t day = (uint64_t) date_epoch / 86400;
+
+  //printf("Year: %d\n", timeinfo.tm_year);
+  //printf("Month: %d\n", timeinfo.tm_mon);
+  //printf("Day: %d\n", timeinfo.tm_mday);
+
+  return day;
+}
+
+
+char* text_append_date(char* text_output, uint64_t day){
+  // convert days since epoch to second since epoch
+  time_t date_epoch = day * 86400;
+
+  // GM time is UTC (GMT timezome - ignoring timezones)
+  struct tm* timeinfo = gmtime(&date_epoch);
+
+  size_t result = strftime(text_output, 11, "%F", timeinfo);
+  assert(result != 0);
+
+  return text_output+10;
+}
+
+
+// comma to separate values in a list. line indexes text_buffer->scan
+void editor_parse_propertyline(Task_Memory* task_memory, User_Memory* user_memory, Task* task, size_t line, Text_Buffer* text_buffer, Text_Cursor* text_cursor){
+  Scan_Index* scan = &text_buffer->scan;
+  char* text = scan->text;
+  char* line_start = text + scan->lines[line].start;
+  char* line_end = line_start + scan->lines[line].length;
+  size_t mark = scan->lines[line].mark_first;
+  // split into property and value parts. split on ':'
+  char* split = text + scan_line_find(scan, line, &mark, line_start - text, ':');
+  int property_str_length;
+  char* property_str = string_strip(&property_str_length, line_start, split - line_start);
+  if (property_str_length == 0){
+    return;
+  }
+
+  int value_str_length;
+  char* value_str = string_strip(&value_str_length, split, line_end - split);
+
+  printf("(task %s) add property='%.*s'  value='%.*s'\n", task->task_name, property_str_length, property_str, value_str_length, value_str);
+  if (value_str_length == 0){
+    return;
+  }
+
+  if ((property_str_length >= 4) && (memcmp(property_str, "user", 4) == 0)){
+    // split on ','
+    char* property_split_start = value_str;
+    char* property_split_end = value_str;
+
+    while(property_split_start < line_end){
+      property_split_end = text + scan_line_find(scan, line, &mark, property_split_start - text, ',');
+
+      // parse what you find
+      int value_length;
+      char* value = string_strip(&value_length, property_split_start, property_split_end - property_split_start);
+      if (value_length > 0){
+        User* user = user_get(user_memory, value, value_length);
+        if (user == NULL){
+          printf("user: '%.*s' NEW!\n", value_length, value);
+          user = user_create(user_memory, value, value_length); 
+        }
+        else{
+          printf("user: '%.*s' EXISTING\n", value_length, value);
+        }
+        user->trash = FALSE;
+        user->mode_edit = TRUE;
+        user_memory->editor_visited[user - user_memory->users] = TRUE;
+
+        // assign to the task, if it is not already there
+        task_user_add(task, user);
+        editor_symbol_push(text_buffer, TEXTCURSOR_ENTITY_USER, user, value - text, value_length);
+
+        // mark in cursor TODO MULTICURSOR
+        if ((text_cursor->pos[0] >= property_split_start - text) && (text_cursor->pos[0] <= property_split_end - text)){
+          text_cursor->entity_type = TEXTCURSOR_ENTITY_USER;
+          text_cursor->entity = (void*) user;
+          printf("  [CURSOR DETECT] says cursor on task '%s', user '%s'\n", task->task_name, user->name);
+        }
+      }
+
+      property_split_start = property_split_end + 1;
+    }
+  }
+
+  else if((property_str_length >= 6) && (memcmp(property_str, "prereq", 6) == 0)){
+    printf("parsing prerequisites\n");
+    char* property_split_start = value_str;
+    char* property_split_end = value_str;
+ 
+    while (property_split_start < line_end){
+      property_split_end = text + scan_line_find(scan, line, &mark, property_split_start - text, ',');
+
+      // parse what you find
+      int value_length;
+      char* value = string_strip(&value_length, property_split_start, property_split_end - property_split_start);
+      if (value_length > 0){
+        Task* prereq = task_get(task_memory, value, value_length);
+        if (prereq != NULL){
+          task->prereqs[task->prereq_qty] = prereq;
+          task->prereq_qty += 1;
+          // not one the text stopped naming, it's trashed after this parse
+          if ((prereq->mode_edit == FALSE) || (task_memory->editor_visited[prereq - task_memory->tasks] == TRUE)){
+            editor_symbol_push(text_buffer, TEXTCURSOR_ENTITY_PREREQ, prereq, value - text, value_length);
+          }
+
+          // mark in cursor TODO MULTICURSOR
+          if ((text_cursor->pos[0] >= property_split_start - text) && (text_cursor->pos[0] <= property_split_end - text)){
+            text_cursor->entity_type = TEXTCURSOR_ENTITY_PREREQ;
+            text_cursor->entity = (void*) prereq;
+            printf("  [CURSOR DETECT] says cursor on task '%s', prereq '%s'\n", task->task_name, prereq->task_name);
+          }
+        }
+        else{
+          // TODO something when dependencies don't exist
+        }
+      }
+
+      property_split_start = property_split_end + 1;
+    }
+  }
+
+  else if((property_str_length >= 8) && (memcmp(property_str, "duration", 8) == 0)){
+    int duration = editor_parse_int(value_str, value_str_length);
+    task->day_duration = duration;
+    task->schedule_constraints |= SCHEDULE_CONSTRAINT_DURATION;
+  }
+  else if((property_str_length >= 11) && (memcmp(property_str, "fixed_start", 11) == 0)){
+    task->schedule_constraints |= SCHEDULE_CONSTRAINT_START;
+    task->day_start = editor_parse_date(value_str, value_str_length);
+  }
+  else if((property_str_length >= 9) && (memcmp(property_str, "fixed_end", 9) == 0)){
+    task->schedule_constraints |= SCHEDULE_CONSTRAINT_END;
+    task->day_end = editor_parse_date(value_str, value_str_length);
+  }
+  else if((property_str_length >= 9) && (memcmp(property_str, "no_sooner", 9) == 0)){
+    task->schedule_constraints |= SCHEDULE_CONSTRAINT_NOSOONER;
+    task->day_no_sooner = editor_parse_date(value_str, value_str_length);
+  }
+
+  else if((property_str_length >= 5) && (memcmp(property_str, "color", 5) == 0)){
+    int color = editor_parse_int(value_str, value_str_length);
+    if ((color > 9) || (color < 0)){
+      color = 0;
+    }
+    task->status_color = color;
+  }
+
+  else{
+    printf("[WARNING] PROPERTY %.*s NOT RECOGNIZED\n", property_str_length, property_str);
+  }
+
+}
+ 
+
+// PASS 2 over the lines in text_buffer->scan. all task properties, now you can scrub dependencies
+void editor_parse_properties(Task_Memory* task_memory, User_Memory* user_memory, Text_Buffer* text_buffer, Text_Cursor* text_cursor){
+  printf("[STATUS] PASS 2 working through the properties\n");
+  Scan_Index* scan = &text_buffer->scan;
+  char* text_start = scan->text;
+  Task* task = NULL;
+  for (size_t l=0; l<scan->line_qty; ++l){
+    Scan_Line* scan_line = scan->lines + l;
+    char* line_start = text_start + scan_line->start;
+    char* line_end = line_start + scan_line->length;
+    int line_working_length = scan_line->length;
+    if (line_working_length == 0){
+      continue;
+    }
+
+    // task open
+    if ((scan_line->marks & SCAN_MARK_OPEN) != 0){
+      // cleanup old tasks that haven't been closed properly yet
+      if (task != NULL){
+        task_user_remove_unvisited(task, user_memory);
+        task = NULL;
+      }
+
+      int task_name_length;
+      char* task_name = string_strip(&task_name_length, line_start, line_working_length);
+      if (task_name_length > 0){
+        task = task_get(task_memory, task_name, task_name_length);
+        assert( task != NULL);
+        editor_symbol_push(text_buffer, TEXTCURSOR_ENTITY_TASK, task, task_name - text_start, task_name_length);
+
+        // its users have to be listed again in this block to stay, whatever the blocks before it said
+        for (size_t u=0; u<task->user_qty; ++u){
+          user_memory->editor_visited[task->users[u] - user_memory->users] = FALSE;
+        }
+      }
+
+      // TODO MULTICURSOR
+      if ((task != NULL) && (text_cursor->pos[0] >= line_start - text_start) && (text_cursor->pos[0] < line_end - text_start)){
+        printf("cursor on line creating task '%s'\n", task->task_name);
+        text_cursor->entity_type = TEXTCURSOR_ENTITY_TASK;
+        text_cursor->entity = (void*) task;
+      }
+    }
+
+    // task close
+    else if ((scan_line->marks & SCAN_MARK_CLOSE) != 0){
+      if (task != NULL){
+        printf("detected '}' ... cleaning up / closing task '%s'\n", task->task_name);
+        task_user_remove_unvisited(task, user_memory);
+        task = NULL;
+      }
+    }
+
+    // property line
+    else if((task != NULL) && ((scan_line->marks & SCAN_MARK_COLON) != 0)){
+      editor_parse_propertyline(task_memory, user_memory, task, l, text_buffer, text_cursor);
+    }
+  } // done going through lines
+
+  // text at the top level creates activities with that name
+  // open bracket increases to the next level
+  // text at the next level causes a lookup for a struct member. colon separator
+
+  // cleanup tasks that are in the progress of being written and don't have a close brace yet
+  if (task != NULL){
+    task_user_remove_unvisited(task, user_memory);
+    task = NULL;
+  }
+}
+
+
+// where the name at s goes once the names found again in a block-only parse, pushed from old_qty on, take the place of
+// [first, after_first). SIZE_MAX stays
+size_t editor_symbol_moved(size_t s, size_t first, size_t after_first, size_t old_qty, size_t new_qty){
+  if ((s == SIZE_MAX) || (s < first)){
+    return s;
+  }
+  if (s >= old_qty){
+    return s - old_qty + first;
+  }
+  return s - after_first + first + new_qty;
+}
+
+
+// last block starting at or before pos, in the text as the last parse saw it
+size_t editor_block_find(Text_Buffer* text_buffer, int pos){
+  size_t low = 0;
+  size_t high = text_buffer->block_qty;
+  while (high - low > 1){
+    size_t middle = (low + high) / 2;
+    if (text_buffer->blocks[middle].start <= pos){
+      low = middle;
+    }
+    else{
+      high = middle;
+    }
+  }
+  return low;
+}
+
+
+// parse again only the blocks that the edits since the last parse touched. the tasks they name have to stay the same,
+// other blocks may refer to them. returns FAILURE without changing anything when that can't be done, for a full parse
+int editor_parse_edits(Task_Memory* task_memory, User_Memory* user_memory, Text_Buffer* text_buffer, Text_Cursor* text_cursor){
+  if ((text_buffer->block_qty == 0) || (text_buffer->parsed_repeats == TRUE)){
+    return FAILURE;
+  }
+  Text_Block* blocks = text_buffer->blocks;
+  Task* tasks = task_memory->tasks;
+  int shift = text_buffer->edit_end - text_buffer->edit_end_parsed;
+
+  // the blocks the edits touched, including one that starts right where they end. and the cursor's block, since
+  // what the cursor is on gets looked up again
+  size_t first = editor_block_find(text_buffer, text_buffer->edit_start);
+  size_t last = editor_block_find(text_buffer, text_buffer->edit_end_parsed);
+  int cursor = text_cursor->pos[0];
+  if (cursor >= text_buffer->edit_end){
+    cursor -= shift;
+  }
+  else if (cursor > text_buffer->edit_start){
+    cursor = text_buffer->edit_start;
+  }
+  size_t cursor_block = editor_block_find(text_buffer, cursor);
+  if (cursor_block < first){
+    first = cursor_block;
+  }
+  if (cursor_block > last){
+    last = cursor_block;
+  }
+
+  // the edits may have taken the '{' or the name off the first line, then its lines belong to the task before. so do
+  // the lines after a '{' with no name
+  int start = blocks[first].start;
+  int end = text_buffer->length;
+  if (last + 1 < text_buffer->block_qty){
+    end = blocks[last + 1].start + shift;
+  }
+  while (first > 0){
+    char* line_start = editor_buffer_view(text_buffer, start, end);
+    char* line_end = memchr(line_start, (int) '\n', end - start);
+    if (line_end == NULL){
+      line_end = line_start + (end - start);
+    }
+    int name_length;
+    string_strip(&name_length, line_start, line_end - line_start);
+    if ((blocks[first].task != SIZE_MAX) && (memchr(line_start, (int) '{', line_end - line_start) != NULL) && (name_length > 0)){
+      break;
+    }
+    first -= 1;
+    start = blocks[first].start;
+  }
+  if ((end < text_buffer->length) && (*editor_buffer_view(text_buffer, end - 1, end) != '\n')){
+    return FAILURE;
+  }
+
+  // the same tasks have to come out. one that's new, gone or named twice means other blocks need a look too
+  // temp_status is left at 0 or 1 by whatever used it last, the blocks' tasks are marked 2, then 3 when named again
+  for (size_t b=first; b<=last; ++b){
+    if (blocks[b].task != SIZE_MAX){
+      task_memory->temp_status[blocks[b].task] = 2;
+    }
+  }
+  Scan_Index* scan = &text_buffer->scan;
+  scan_text(scan, editor_buffer_view(text_buffer, start, end) - start, start, end);
+  int same = TRUE;
+  for (size_t l=0; (l < scan->line_qty) && (same == TRUE); ++l){
+    if ((scan->lines[l].marks & SCAN_MARK_OPEN) != 0){
+      int task_name_length;
+      char* task_name = string_strip(&task_name_length, scan->text + scan->lines[l].start, scan->lines[l].length);
+      if (task_name_length > 0){
+        Task* task = task_get(task_memory, task_name, task_name_length);
+        if ((task == NULL) || (task_memory->temp_status[task - tasks] != 2)){
+          same = FALSE;
+        }
+        else{
+          task_memory->temp_status[task - tasks] = 3;
+        }
+      }
+    }
+  }
+  for (size_t b=first; b<=last; ++b){
+    if (blocks[b].task != SIZE_MAX){
+      if (task_memory->temp_status[blocks[b].task] != 3){
+        same = FALSE;
+      }
+      task_memory->temp_status[blocks[b].task] = 0;
+    }
+  }
+  if (same == FALSE){
+    return FAILURE;
+  }
+  printf("[STATUS] parsing blocks %lu to %lu of %lu, bytes %d to %d of %d\n", first, last, text_buffer->block_qty, start, end, text_buffer->length);
+
+  // forget what the old blocks said. what they listed is kept to update the rest of the plan from, only around them
+  size_t block_task_qty = 0;
+  Task** block_tasks = (Task**) malloc((last - first + 1) * sizeof(Task*));
+  Task** prereqs_old = (Task**) malloc((last - first + 1) * TASK_DEPENDENCIES_MAX * sizeof(Task*));
+  size_t* prereq_old_qty = (size_t*) malloc((last - first + 1) * sizeof(size_t));
+  User** users_old = (User**) malloc((last - first + 1) * TASK_USERS_MAX * sizeof(User*));
+  size_t user_old_qty = 0;
+  for (size_t b=first; b<=last; ++b){
+    if (blocks[b].task != SIZE_MAX){
+      Task* task = tasks + blocks[b].task;
+      block_tasks[block_task_qty] = task;
+      prereq_old_qty[block_task_qty] = task->prereq_qty;
+      memcpy(prereqs_old + block_task_qty * TASK_DEPENDENCIES_MAX, task->prereqs, task->prereq_qty * sizeof(Task*));
+      block_task_qty += 1;
+      for (size_t p=0; p<task->prereq_qty; ++p){
+        task_dependent_remove(task->prereqs[p], task);
+      }
+      memcpy(users_old + user_old_qty, task->users, task->user_qty * sizeof(User*));
+      user_old_qty += task->user_qty;
+
+      if (task->mode_edit == TRUE){
+        task->prereq_qty = 0;
+        task->schedule_constraints = 0;
+      }
+    }
+  }
+  text_cursor->entity_type = TEXTCURSOR_ENTITY_NONE;
+  text_cursor->entity = NULL;
+
+  // the lines after the blocks move up or down, the blocks after them over
+  int line = blocks[first].line;
+  int lines_parsed = text_buffer->parsed_lines - line;
+  if (last + 1 < text_buffer->block_qty){
+    lines_parsed = blocks[last + 1].line - line;
+  }
+  int lines = scan->line_qty;
+  int lines_after = text_buffer->parsed_lines - line - lines_parsed;
+  editor_buffer_reserve(text_buffer, 0, line + lines + lines_after + 1);
+  memmove(text_buffer->line_task + line + lines, text_buffer->line_task + line + lines_parsed, lines_after * sizeof(Task*));
+
+  // the blocks found again go on the end for now, then in place of the old ones. the ones after them only move over
+  size_t block_old_qty = text_buffer->block_qty;
+  size_t after_qty = block_old_qty - (last + 1);
+  editor_parse_task_detect(task_memory, text_buffer, line);
+  size_t block_new_qty = text_buffer->block_qty - block_old_qty;
+  Text_Block* block_new = (Text_Block*) malloc((block_new_qty + 1) * sizeof(Text_Block));
+  blocks = text_buffer->blocks;
+  memcpy(block_new, blocks + block_old_qty, block_new_qty * sizeof(Text_Block));
+  memmove(blocks + first + block_new_qty, blocks + last + 1, after_qty * sizeof(Text_Block));
+  memcpy(blocks + first, block_new, block_new_qty * sizeof(Text_Block));
+  free(block_new);
+  text_buffer->block_qty = first + block_new_qty + after_qty;
+  for (size_t b=first+block_new_qty; b<text_buffer->block_qty; ++b){
+    blocks[b].start += shift;
+    blocks[b].line += lines - lines_parsed;
+  }
+
+  // the names in the blocks are found again, the same way. the places each entity is named point at where the
+  // names move to
+  size_t symbol_first = editor_symbol_find(text_buffer, start);
+  size_t symbol_after_first = editor_symbol_find(text_buffer, end - shift);
+  size_t symbol_old_qty = text_buffer->symbol_qty;
+  size_t symbol_after_qty = symbol_old_qty - symbol_after_first;
+  for (size_t i=symbol_first; i<symbol_after_first; ++i){
+    editor_symbol_unlink(text_buffer, i);
+  }
+  editor_parse_properties(task_memory, user_memory, text_buffer, text_cursor);
+  size_t symbol_new_qty = text_buffer->symbol_qty - symbol_old_qty;
+  Text_Symbol* symbols = text_buffer->symbols;
+  for (size_t i=symbol_after_first; i<text_buffer->symbol_qty; ++i){
+    Text_Symbol* symbol = symbols + i;
+    size_t moved = editor_symbol_moved(i, symbol_first, symbol_after_first, symbol_old_qty, symbol_new_qty);
+    if (symbol->prev == SIZE_MAX){
+      *editor_symbol_head(symbol->type, symbol->entity) = moved;
+    }
+    else if (symbol->prev < symbol_first){
+      symbols[symbol->prev].next = moved;
+    }
+    if ((symbol->next != SIZE_MAX) && (symbol->next < symbol_first)){
+      symbols[symbol->next].prev = moved;
+    }
+    symbol->prev = editor_symbol_moved(symbol->prev, symbol_first, symbol_after_first, symbol_old_qty, symbol_new_qty);
+    symbol->next = editor_symbol_moved(symbol->next, symbol_first, symbol_after_first, symbol_old_qty, symbol_new_qty);
+  }
+  Text_Symbol* symbol_new = (Text_Symbol*) malloc((symbol_new_qty + 1) * sizeof(Text_Symbol));
+  memcpy(symbol_new, symbols + symbol_old_qty, symbol_new_qty * sizeof(Text_Symbol));
+  memmove(symbols + symbol_first + symbol_new_qty, symbols + symbol_after_first, symbol_after_qty * sizeof(Text_Symbol));
+  memcpy(symbols + symbol_first, symbol_new, symbol_new_qty * sizeof(Text_Symbol));
+  free(symbol_new);
+  text_buffer->symbol_qty = symbol_first + symbol_new_qty + symbol_after_qty;
+  for (size_t i=symbol_first+symbol_new_qty; i<text_buffer->symbol_qty; ++i){
+    symbols[i].start += shift;
+  }
+  text_buffer->parsed_lines += lines - lines_parsed;
+
+  // users the blocks took off their tasks may have none left. the loops only change through a prereq the blocks
+  // dropped from a task on one, or one they added that already leads back to the task
+  for (size_t u=0; u<user_old_qty; ++u){
+    editor_user_cleanup(user_memory, users_old[u]);
+  }
+  uint8_t cycles_changed = FALSE;
+  for (size_t t=0; t<block_task_qty; ++t){
+    Task* task = block_tasks[t];
+    Task** prereqs = prereqs_old + t * TASK_DEPENDENCIES_MAX;
+    for (size_t p=0; p<task->prereq_qty; ++p){
+      task_dependent_add(task->prereqs[p], task);
+      uint8_t listed = FALSE;
+      for (size_t o=0; o<prereq_old_qty[t]; ++o){
+        listed |= (prereqs[o] == task->prereqs[p]);
+      }
+      if ((listed == FALSE) && (cycles_changed == FALSE)){
+        cycles_changed = task_prereq_reaches(task_memory, task->prereqs[p], task);
+      }
+    }
+    if (task->cycle == TRUE){
+      for (size_t o=0; o<prereq_old_qty[t]; ++o){
+        uint8_t listed = FALSE;
+        for (size_t p=0; p<task->prereq_qty; ++p){
+          listed |= (prereqs[o] == task->prereqs[p]);
+        }
+        if (listed == FALSE){
+          cycles_changed = TRUE;
+        }
+      }
+    }
+  }
+  if (cycles_changed == TRUE){
+    task_cycles_find(task_memory);
+  }
+  free(block_tasks);
+  free(prereqs_old);
+  free(prereq_old_qty);
+  free(users_old);
+  return SUCCESS;
+}
+
+
+// in edit mode, lock the Activity_Node ids that are being shown in the edit pane.
+// modify the full network directly. automatically delete/re-add everything being edited in edit mode. assume all those nodes selected are trashed and revised. 
+// only the blocks around the edits noted with editor_buffer_edited() are parsed again, when that's enough
+void editor_parse_text(Task_Memory* task_memory, User_Memory* user_memory, Text_Buffer* text_buffer, Text_Cursor* text_cursor){
+  uint64_t cpu_timer_start = SDL_GetPerformanceCounter();
+
+  Task* tasks = task_memory->tasks;
+  uint8_t edits_only = FALSE;
+  if ((text_buffer->edit_all == FALSE) && (text_buffer->edit_pending == TRUE)){
+    edits_only = (editor_parse_edits(task_memory, user_memory, text_buffer, text_cursor) == SUCCESS);
+  }
+
+  if (edits_only == FALSE){
+    // track difference betweeen seen [tasks, users] and expected to see tasks
+    // if you don't see items that you expect to.. need to remove those!
+    for (size_t i=0; i<task_memory->allocation_total; ++i){
+      task_memory->editor_visited[i] = FALSE;
+    }
+    for (size_t i=0; i<user_memory->allocation_total; ++i){
+      user_memory->editor_visited[i] = FALSE;
+    }
+    for (size_t i=0; i<task_memory->allocation_total; ++i){
+      if (tasks[i].mode_edit == TRUE){
+        tasks[i].prereq_qty = 0; // TODO is there a better way to do this? using mode_edit and cleanup?
+        //tasks[i].user_qty = 0;
+      }
+    }
+    text_cursor->entity_type = TEXTCURSOR_ENTITY_NONE;
+    text_cursor->entity = NULL;
+
+    // PASS 1 - just add/remove tasks, mark them as visited. new tasks are marked edit_mode = TRUE
+    scan_text(&text_buffer->scan, editor_buffer_view(text_buffer, 0, text_buffer->length), 0, text_buffer->length);
+    text_buffer->block_qty = 0;
+    text_buffer->parsed_lines = editor_parse_task_detect(task_memory, text_buffer, 0);
+
+    // a task named twice. the edits can't bring in new names, so checking here is enough
+    text_buffer->parsed_repeats = FALSE;
+    memset(task_memory->temp_status, 0, task_memory->allocation_total * sizeof(*task_memory->temp_status));
+    for (size_t b=0; b<text_buffer->block_qty; ++b){
+      size_t t = text_buffer->blocks[b].task;
+      if (t != SIZE_MAX){
+        if (task_memory->temp_status[t] == 1){
+          text_buffer->parsed_repeats = TRUE;
+        }
+        task_memory->temp_status[t] = 1;
+      }
+    }
+
+    // reset some properties for all tasks in the editor
+    for (size_t t=0; t<task_memory->allocation_total; ++t){
+      if (task_memory->tasks[t].mode_edit == TRUE){
+        task_memory->tasks[t].schedule_constraints = 0;
+      }
+    }
+
+    // PASS 2 - all task properties, now you can scrub dependencies
+    text_buffer->symbol_qty = 0;
+    editor_parse_properties(task_memory, user_memory, text_buffer, text_cursor);
+
+    editor_tasks_cleanup(task_memory);
+    editor_users_cleanup(user_memory);
+    task_dependents_find_all(task_memory);
+    task_cycles_find(task_memory);
+  }
+  text_buffer->parsed_length = text_buffer->length;
+  text_buffer->edit_all = FALSE;
+  text_buffer->edit_pending = FALSE;
+
+  uint64_t cpu_timer_end = SDL_GetPerformanceCounter();
+  double cpu_timer_elapsed = ((double) cpu_timer_end - cpu_timer_start) / ((double) SDL_GetPerformanceFrequency());
+  printf("[STATUS] Finished parsing text this round, time: %.3lf ms\n", cpu_timer_elapsed*1000);
+
+  // TODO add better error handling warning stuff
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void editor_cursor_reset(Text_Cursor* text_cursor){
+  text_cursor->pos[0] = 0;
+  text_cursor->x[0] = 0;
+  text_cursor->y[0] = 0;
+  text_cursor->qty = 1;
+  text_cursor->entity_type = TEXTCURSOR_ENTITY_NONE;
+}
+
+
+Text_Cursor* editor_cursor_create(){
+  Text_Cursor* text_cursor = (Text_Cursor*) malloc(sizeof(Text_Cursor));
+  text_cursor->pos = malloc(CURSOR_QTY_MAX * sizeof(*text_cursor->pos));
+  text_cursor->x   = malloc(CURSOR_QTY_MAX * sizeof(*text_cursor->x));
+  text_cursor->y   = malloc(CURSOR_QTY_MAX * sizeof(*text_cursor->y));
+  editor_cursor_reset(text_cursor);
+  text_cursor->task = NULL;
+
+  return text_cursor;
+}
+
+
+void editor_cursor_destroy(Text_Cursor* text_cursor){
+  free(text_cursor->pos);
+  free(text_cursor->x);
+  free(text_cursor->y);
+  free(text_cursor);
+}
+
+
+// given pos, find xy character index for all cursor. shows a problem with 0/1 length lines?
+void editor_cursor_xy_get(Text_Buffer* text_buffer, Text_Cursor* text_cursor){
+  // each one is looked up in the line tree, O(log lines)
+  for (size_t index=0; index<text_cursor->qty; ++index){
+    text_cursor->y[index] = editor_line_locate(text_buffer, text_cursor->pos[index], &text_cursor->x[index]);
+    printf("pos: %d --> (x,y) = (%d, %d)\n", text_cursor->pos[index], text_cursor->x[index], text_cursor->y[index]);
+
+    // check assumption of cursor ordering
+    if (index > 0){
+      assert(text_cursor->pos[index] > text_cursor->pos[index-1]);
+    }
+  }
+}
+
+
+// set x and y position of cursor, set cursor->pos to the correct value
+// assuming that text_buffer->line_lengths are correct
+void editor_cursor_xy_set(Text_Buffer* text_buffer, Text_Cursor* text_cursor, size_t index, int x, int y){
+  assert(y <= text_buffer->lines);
+  text_cursor->x[index] = x;
+  text_cursor->y[index] = y;
+
+  text_cursor->pos[index] = editor_line_start(text_buffer, y) + x;
+}
+
+
+// lookup what task is pointed to by the editor mode cursor
+void editor_cursor_find_task(Text_Buffer* text_buffer, Text_Cursor* text_cursor){
+  text_cursor->task = text_buffer->line_task[text_cursor->y[0]];
+}
+
+
+size_t editor_cursor_quicksort_partition(int* list, size_t start, size_t end){
+   // pivot value, from the middle of the array
+   int pivot_index = (int) floor((start + end)/2.0 );
+   int pivot = list[pivot_index];
+
+   // left index
+   size_t i = start - 1;
+
+   // right index
+   size_t j = end + 1;
+
+   for(;;){
+      // move the left index to the right (at least once) 
+      // and while element at the left is less than the pivot
+      do {
+         ++i;
+      } while(list[i] < pivot);
+
+      // move the right index to the left at least once 
+      // and while element at the right index is greater than the pivot
+      do {
+         --j;
+      } while (list[j] > pivot);
+
+      // if indices crossed, give up!
+      if (i >= j){
+         return j;
+      }
+
+      // swap
+      int tmp = list[i];
+      list[i] = list[j];
+      list[j] = tmp;
+   }
+
+}
+
+// quicksort thanks to wikipedia ! Hoare partition
+void editor_cursor_quicksort(int* list, size_t start, size_t end){
+   // if ((start >= 0) & (end >= 0) & (start < end)){
+   if (start < end){
+
+      // partition and get pivot index
+      size_t pivot_loc = editor_cursor_quicksort_partition(list, start, end);
+
+      // recursive break into subproblems
+      editor_cursor_quicksort(list, start, pivot_loc);
+      editor_cursor_quicksort(list, pivot_loc+1, end);
+   }
+  
+   return;
+}
+
+
+// sort the cursors in descending order, then recompute xy coordinates
+void editor_cursor_sort(Text_Buffer* text_buffer, Text_Cursor* text_cursor){
+  // sort pos using quicksort
+  editor_cursor_quicksort(text_cursor->pos, 0, text_cursor->qty-1);
+
+  // then process to recompute xy
+  printf("result after sorting..\n");
+  editor_cursor_xy_get(text_buffer, text_cursor);
+}
+
+
+// move one cursor by the given amount
+void editor_cursor_move(Text_Buffer* tb, Text_Cursor* tc, size_t index, int movedir){
+  if (movedir == TEXTCURSOR_MOVE_DIR_RIGHT){
+    if (tc->pos[index] < tb->length-1){
+      tc->pos[index] += 1;
+      tc->x[index] += 1;
+      
+      // wrap to next line
+      if (tc->x[index] == tb->line_length[tc->y[index]]){
+        tc->x[index] = 0;
+        tc->y[index] += 1;
+      }
+    }
+  }
+  else if (movedir == TEXTCURSOR_MOVE_DIR_LEFT){
+    if (tc->pos[index] > 0){
+      tc->pos[index] -= 1;
+      tc->x[index] -= 1;
+
+      // wrap to previous line
+      if(tc->x[index]  < 0){
+        tc->y[index] -= 1;
+        tc->x[index] = tb->line_length[tc->y[index]] - 1;
+      }
+    }
+  }
+  else if (movedir == TEXTCURSOR_MOVE_DIR_UP){
+    if (tc->y[index] > 0){
+      tc->y[index] -= 1;
+
+      int x_delta = tc->x[index];
+      // moving on to a shorter line
+      if (tc->x[index] >= tb->line_length[tc->y[index]]){
+        tc->x[index] = tb->line_length[tc->y[index]]-1;
+        tc->pos[index] -= x_delta + 1;
+      }
+      // moving onto a longer line
+      else{
+        x_delta += tb->line_length[tc->y[index]] - tc->x[index];
+        tc->pos[index] -= x_delta;
+      }
+    }
+  }
+  else if (movedir == TEXTCURSOR_MOVE_DIR_DOWN){
+    if (tc->y[index] < tb->lines-1){
+      int x_delta = tb->line_length[tc->y[index]] - tc->x[index];
+      tc->y[index] += 1;
+
+      // moving onto a shorter line
+      if (tc->x[index] >= tb->line_length[tc->y[index]]){
+        tc->x[index] = tb->line_length[tc->y[index]]-1;
+      }
+        
+      tc->pos[index] += x_delta + tc->x[index];
+    }
+  }
+  else if (movedir == TEXTCURSOR_MOVE_LINE_START){
+    tc->pos[index] -= tc->x[index];
+    tc->x[index] = 0;
+  }
+  else if (movedir == TEXTCURSOR_MOVE_LINE_END){
+    int x_delta = tb->line_length[tc->y[index]] - tc->x[index] - 1;
+    if (x_delta > 0){
+      tc->pos[index] += x_delta;
+      tc->x[index] += x_delta;
+    }
+  }
+
+  printf("move index %lu in direction %d\n", index, movedir);
+}
+
+
+// keys pressed at every cursor, applied with the rest of the frame's by editor_key_batch_flush()
+void editor_key_batch_backspace(Text_Key_Batch* batch){
+  if (batch->text_length > 0){
+    batch->text_length -= 1;
+  }
+  else{
+    batch->backspaces += 1;
+  }
+}
+
+void editor_key_batch_delete(Text_Key_Batch* batch){
+  batch->deletes += 1;
+}
+
+
+// apply the batched keys at every cursor in one editor_buffer_apply(). the cursors move by what the edits before them
+// added and removed, and cursors that ran into each other become one. returns TRUE if there was anything to apply
+uint8_t editor_key_batch_flush(Text_Buffer* tb, Text_Cursor* tc, Text_Key_Batch* batch){
+  if ((batch->backspaces == 0) && (batch->deletes == 0) && (batch->text_length == 0)){
+    return FALSE;
+  }
+
+  // each cursor's edit stops where the one before ended
+  Text_Edit* edits = (Text_Edit*) malloc(tc->qty * sizeof(Text_Edit));
+  int end = 0;
+  for (size_t i=0; i<tc->qty; ++i){
+    int start = tc->pos[i] - batch->backspaces;
+    if (start < end){
+      start = end;
+    }
+    int stop = tc->pos[i] + batch->deletes;
+    if (stop > tb->length){
+      stop = tb->length;
+    }
+    if (stop < start){
+      stop = start;
+    }
+    edits[i].pos = start;
+    edits[i].removed = stop - start;
+    edits[i].inserted = batch->text_length;
+    edits[i].bytes = 0;
+    end = stop;
+  }
+  editor_buffer_apply(tb, edits, tc->qty, batch->text);
+
+  int shift = 0;
+  size_t qty = 0;
+  for (size_t i=0; i<tc->qty; ++i){
+    int pos = edits[i].pos + shift + edits[i].inserted;
+    shift += edits[i].inserted - edits[i].removed;
+    if ((qty == 0) || (pos > tc->pos[qty - 1])){
+      tc->pos[qty] = pos;
+      qty += 1;
+    }
+  }
+  tc->qty = qty;
+  free(edits);
+
+  batch->backspaces = 0;
+  batch->deletes = 0;
+  batch->text_length = 0;
+  editor_cursor_xy_get(tb, tc);
+  return TRUE;
+}
+
+// text typed at every cursor. a full batch is applied first
+void editor_key_batch_text(Text_Buffer* tb, Text_Cursor* tc, Text_Key_Batch* batch, const char* text, int length){
+  if (batch->text_length + length > TEXT_KEY_BATCH_MAX){
+    editor_key_batch_flush(tb, tc, batch);
+  }
+  memcpy(batch->text + batch->text_length, text, length);
+  batch->text_length += length;
+}
+
+
+// apply edits sorted from the last to the first, the order undo finds them in
+void editor_journal_apply_reversed(Text_Buffer* tb, Text_Edit* edits, size_t qty, const char* bytes){
+  for (size_t i=0; i<qty/2; ++i){
+    Text_Edit swap = edits[i];
+    edits[i] = edits[qty - 1 - i];
+    edits[qty - 1 - i] = swap;
+  }
+  editor_buffer_apply(tb, edits, qty, bytes);
+}
+
+
+// take back the last group of edits, and put the cursor where the first of them was. the inverse of each record is
+// what it inserted replaced by what it removed, and all of those that don't overlap go in one editor_buffer_apply(),
+// so it costs what the edits changed, not the size of the text. returns FALSE if there's nothing to undo
+uint8_t editor_journal_undo(Text_Buffer* tb, Text_Cursor* tc){
+  Text_Journal* j = tb->journal;
+  if ((j == NULL) || (j->head == j->tail)){
+    return FALSE;
+  }
+
+  // how many records the group has, and how many bytes they get back
+  Text_Journal_Record record;
+  size_t qty = 0;
+  size_t bytes_qty = 0;
+  size_t start = j->head;
+  do {
+    editor_journal_read_back(j, start, &record);
+    start = record.start;
+    qty += 1;
+    bytes_qty += record.removed;
+  } while (((record.flags & JOURNAL_GROUP_START) == 0) && (start != j->tail));
+
+  // newest first. each record's position is in the text as it was after the ones before it, so as long as one ends
+  // before the next one taken back starts, they're all positions in the text as it is now
+  Text_Edit* edits = (Text_Edit*) malloc(qty * sizeof(Text_Edit));
+  char* bytes = (char*) malloc(bytes_qty + 1);
+  size_t batch = 0;
+  int bytes_used = 0;
+  size_t end = j->head;
+  j->replaying = TRUE;
+  for (size_t i=0; i<qty; ++i){
+    editor_journal_read_back(j, end, &record);
+    end = record.start;
+    if ((batch > 0) && (record.pos + record.inserted > edits[batch - 1].pos)){
+      editor_journal_apply_reversed(tb, edits, batch, bytes);
+      batch = 0;
+      bytes_used = 0;
+    }
+    edits[batch].pos = record.pos;
+    edits[batch].removed = record.inserted;
+    edits[batch].inserted = record.removed;
+    edits[batch].bytes = bytes_used;
+    editor_journal_get(j, record.removed_at, bytes + bytes_used, record.removed);
+    bytes_used += record.removed;
+    batch += 1;
+  }
+  editor_journal_apply_reversed(tb, edits, batch, bytes);
+  j->replaying = FALSE;
+  j->head = start;
+  j->group_open = FALSE;
+  free(edits);
+  free(bytes);
+
+  tc->qty = 1;
+  tc->pos[0] = record.pos + record.removed;
+  editor_cursor_xy_get(tb, tc);
+  return TRUE;
+}
+
+
+// make the last group undone again, and put the cursor after the last of its edits. returns FALSE if there's nothing
+// to redo
+uint8_t editor_journal_redo(Text_Buffer* tb, Text_Cursor* tc){
+  Text_Journal* j = tb->journal;
+  if ((j == NULL) || (j->head == j->redo_end)){
+    return FALSE;
+  }
+
+  Text_Journal_Record record;
+  size_t qty = 0;
+  size_t bytes_qty = 0;
+  size_t end = j->head;
+  do {
+    editor_journal_read(j, end, &record);
+    end = record.end;
+    qty += 1;
+    bytes_qty += record.inserted;
+  } while ((end != j->redo_end) && ((j->bytes[end % j->size] & JOURNAL_GROUP_START) == 0));
+
+  // oldest first, taken back by what the ones before it in the batch moved it, to where it was before them
+  Text_Edit* edits = (Text_Edit*) malloc(qty * sizeof(Text_Edit));
+  char* bytes = (char*) malloc(bytes_qty + 1);
+  size_t batch = 0;
+  int bytes_used = 0;
+  int shift = 0;
+  size_t start = j->head;
+  j->replaying = TRUE;
+  for (size_t i=0; i<qty; ++i){
+    editor_journal_read(j, start, &record);
+    start = record.end;
+    int pos = record.pos - shift;
+    if ((batch > 0) && (pos < edits[batch - 1].pos + edits[batch - 1].removed)){
+      editor_buffer_apply(tb, edits, batch, bytes);
+      batch = 0;
+      bytes_used = 0;
+      shift = 0;
+      pos = record.pos;
+    }
+    edits[batch].pos = pos;
+    edits[batch].removed = record.removed;
+    edits[batch].inserted = record.inserted;
+    edits[batch].bytes = bytes_used;
+    editor_journal_get(j, record.inserted_at, bytes + bytes_used, record.inserted);
+    bytes_used += record.inserted;
+    shift += record.inserted - record.removed;
+    batch += 1;
+  }
+  editor_buffer_apply(tb, edits, batch, bytes);
+  j->replaying = FALSE;
+  j->head = end;
+  j->group_open = FALSE;
+  free(edits);
+  free(bytes);
+
+  tc->qty = 1;
+  tc->pos[0] = record.pos + record.inserted;
+  editor_cursor_xy_get(tb, tc);
+  return TRUE;
+}
+
+
+// clear text_buffer, load from a file [filename] and parse it
+void editor_load_text(Task_Memory* task_memory, User_Memory* user_memory, Text_Buffer* text_buffer, const char* filename, Text_Cursor* text_cursor){
+
+  // open the file, create if not exist, use persmissions of current user
+  FILE* fd = fopen(filename, "r"); 
+  if (fd != NULL){
+    editor_buffer_read(text_buffer, fd);
+    fclose(fd);
+    printf("loaded text of length %d\n", text_buffer->length);
+    printf("text is '%.*s'\n", text_buffer->length, text_buffer->text);
+  }
+  else{
+    printf("[WARNING] FILE '%s' DOES NOT EXIST, CREATING IT\n", filename);
+    fd = fopen(filename, "w");
+    fprintf(fd, " ");
+    fclose(fd);
+
+    // start an empty text buffer
+    editor_buffer_clear(text_buffer);
+    text_buffer->text[0] = ' ';
+    editor_buffer_written(text_buffer, 1);
+  }
+
+  // do an initial parse of the text information 
+  text_buffer->edit_all = TRUE;
+  for (size_t t=0; t<task_memory->allocation_total; ++t){
+    task_memory->tasks[t].mode_edit = TRUE;
+  }
+  editor_parse_text(task_memory, user_memory, text_buffer, text_cursor);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+char* text_append_char(char* text, char new){
+  *text = new;
+  ++text;
+  return text;
+}
+
+
+char* text_append_string(char* text, char* addition){
+  int length = snprintf(NULL, 0, "%s", addition);
+  memcpy(text, addition, length);
+  text += length;
+  return text;
+}
+
+
+// TODO rename to something better - "generate?"
+void editor_text_from_data(Task_Memory* task_memory, Text_Buffer* text_buffer, uint8_t all_tasks){
+  // the new text is written out in full, then replaces the old as one edit of what changed. at most 9 lines a task,
+  // and the names plus a bit for each line
+  int text_qty = 1;
+  int line_qty = 1;
+  for (size_t t=0; t<task_memory->allocation_total; ++t){
+    Task* task = task_memory->tasks + t;
+    if ((task->trash == FALSE) && ((task->mode_edit == TRUE) || (task->mode_edit_temp == TRUE) || (all_tasks == TRUE))){
+      text_qty += 256 + task->task_name_length;
+      for (size_t i=0; i<task->prereq_qty; ++i){
+        text_qty += task->prereqs[i]->task_name_length + 2;
+      }
+      for (size_t u=0; u<task->user_qty; ++u){
+        text_qty += task->users[u]->name_length + 2;
+      }
+      line_qty += 9;
+    }
+  }
+  editor_buffer_reserve(text_buffer, 0, line_qty);
+
+  char* text_start = (char*) malloc(text_qty * sizeof(char));
+  char* text = text_start;
+  int line_number = 0;
+  text_buffer->symbol_qty = 0; // the names are where they get written
+
+  // Fill the new one
+  for (size_t t=0; t<task_memory->allocation_total; ++t){
+    Task* task = task_memory->tasks + t;
+    if (task->trash == FALSE){
+      if ((task->mode_edit == TRUE) || (task->mode_edit_temp == TRUE) || (all_tasks == TRUE)){
+        // task name
+        editor_symbol_push(text_buffer, TEXTCURSOR_ENTITY_TASK, task, text - text_start, task->task_name_length);
+        memcpy(text, task->task_name, task->task_name_length);
+        text += task->task_name_length;
+        text = text_append_string(text, " {\n");
+
+        text_buffer->line_task[line_number] = task;
+        ++line_number;
+
+        // duration
+        if ((task->schedule_constraints & SCHEDULE_CONSTRAINT_DURATION) > 0){
+          text = text_append_string(text, "  duration: ");
+          int length = snprintf(NULL, 0, "%ld", task->day_duration);
+          int result = snprintf(text, length+1, "%ld", task->day_duration); // +1 due to how snprintf accounts for \0
+          assert(result > 0);
+          text += length;
+          text = text_append_char(text, '\n');
+
+          text_buffer->line_task[line_number] = task;
+          ++line_number;
+        }
+          
+        // prereqs (dependency)
+        if (task->prereq_qty > 0){
+          text = text_append_string(text, "  prereq: ");
+
+          for (size_t i=0; i<task->prereq_qty; ++i){
+            editor_symbol_push(text_buffer, TEXTCURSOR_ENTITY_PREREQ, task->prereqs[i], text - text_start, task->prereqs[i]->task_name_length);
+            memcpy(text, task->prereqs[i]->task_name, task->prereqs[i]->task_name_length);
+            text += task->prereqs[i]->task_name_length;
+            text = text_append_string(text, ", ");
+          }
+          text -= 2;
+          text = text_append_char(text, '\n');
+
+          text_buffer->line_task[line_number] = task;
+          ++line_number;
+        }
+        
+        // users
+        if (task->user_qty > 0){
+          text = text_append_string(text, "  user: ");
+
+          for (size_t u=0; u<task->user_qty; ++u){
+            editor_symbol_push(text_buffer, TEXTCURSOR_ENTITY_USER, task->users[u], text - text_start, task->users[u]->name_length);
+            memcpy(text, task->users[u]->name, task->users[u]->name_length);
+            text += task->users[u]->name_length;
+            text = text_append_string(text, ", ");
+          }
+          text -= 2;
+          text = text_append_char(text, '\n');
+
+          text_buffer->line_task[line_number] = task;
+          ++line_number;
+        }
+
+        // fixed dates
+        if ((task->schedule_constraints & SCHEDULE_CONSTRAINT_START) > 0){
+          text = text_append_string(text, "  fixed_start: ");
+          text = text_append_date(text, task->day_start);
+          text = text_append_char(text, '\n');
+
+          text_buffer->line_task[line_number] = task;
+          ++line_number;
+        }
+        if ((task->schedule_constraints & SCHEDULE_CONSTRAINT_END) > 0){
+          text = text_append_string(text, "  fixed_end: ");
+          text = text_append_date(text, task->day_end);
+          text = text_append_char(text, '\n');
+
+          text_buffer->line_task[line_number] = task;
+          ++line_number;
+        }
+        if ((task->schedule_constraints & SCHEDULE_CONSTRAINT_NOSOONER) > 0){
+          text = text_append_string(text, "  no_sooner: ");
+          text = text_append_date(text, task->day_no_sooner);
+          text = text_append_char(text, '\n');
+
+          text_buffer->line_task[line_number] = task;
+          ++line_number;
+        }
+
+        // color
+        {
+          text = text_append_string(text, "  color: ");
+          int length = snprintf(NULL, 0, "%u", task->status_color);
+          int result = snprintf(text, length+1, "%u", task->status_color);
+          assert(result > 0);
+          text += length;
+          text = text_append_char(text, '\n');
+
+          text_buffer->line_task[line_number] = task;
+          ++line_number;
+        }
+
+        // end this task
+        text = text_append_string(text, "}\n");
+
+        text_buffer->line_task[line_number] = task;
+        ++line_number;
+      }
+    }
+  }
+  if (text == text_start){
+    text = text_append_char(text, ' ');
+  }
+  editor_buffer_replace(text_buffer, text_start, text - text_start);
+  free(text_start);
+  text_buffer->edit_all = TRUE;
+}
+
+
+void text_buffer_save(Text_Buffer* text_buffer, char* filename){
+
+  FILE* fd = fopen(filename, "w");
+  if (fd != NULL){
+    fprintf(fd, "%.*s", text_buffer->length, editor_buffer_view(text_buffer, 0, text_buffer->length));
+    fclose(fd);
+    printf("[INFO] save successful.\n");
+  }
+  else{
+    printf("[ERROR] could not open file '%s'.\n", filename);
+  }
+}
+
+
+// put a cursor at the end of every place the name under the first cursor is used, so typing renames it everywhere.
+// tasks that use the name but aren't in the editor yet are put in edit mode and the text is regenerated with them.
+// returns TRUE if it was
+uint8_t editor_symbol_rename(Task_Memory* task_memory, User_Memory* user_memory, Text_Buffer* text_buffer, Text_Cursor* text_cursor){
+  printf("[SYMBOL RENAME] FUNCTION ACTIVATED**********************************\n");
+  if (text_cursor->qty > 1){
+    printf("[WARNING] CURRENT ENTITY BASED ONLY ON FIRST CURSOR [0]\n");
+  }
+
+  // the names have to be where the text says they are now
+  if ((text_buffer->edit_all == TRUE) || (text_buffer->edit_pending == TRUE)){
+    editor_parse_text(task_memory, user_memory, text_buffer, text_cursor);
+  }
+  Text_Symbol* symbol = editor_symbol_at(text_buffer, text_cursor->pos[0]);
+  if (symbol == NULL){
+    printf("[WARNING] NO TASK OR USER NAME AT THE CURSOR\n");
+    return FALSE;
+  }
+  void* entity = symbol->entity;
+  uint8_t type = symbol->type;
+
+  // mark all related tasks in edit mode
+  uint8_t selection_changed = FALSE;
+  if (symbol->type == TEXTCURSOR_ENTITY_USER){
+    User* user = (User*) entity;
+    printf("renaming user '%s'\n", user->name);
+    for (size_t t=0; t<user->task_qty; ++t){
+      if (user->tasks[t]->mode_edit == FALSE){
+        user->tasks[t]->mode_edit = TRUE;
+        selection_changed = TRUE;
+      }
+    }
+  }
+  else{
+    Task* task = (Task*) entity;
+    printf("renaming task '%s'\n", task->task_name);
+    if (task->mode_edit == FALSE){
+      task->mode_edit = TRUE;
+      selection_changed = TRUE;
+    }
+    for (size_t t=0; t<task->dependent_qty; ++t){
+      if (task->dependents[t]->mode_edit == FALSE){
+        task->dependents[t]->mode_edit = TRUE;
+        selection_changed = TRUE;
+      }
+    }
+  }
+
+  // regenerate text.. which finds the names again as it writes them
+  if (selection_changed == TRUE){
+    editor_text_from_data(task_memory, text_buffer, FALSE);
+  }
+
+  // now deploy the multi-cursors! one at the end of each place the name is used, then in text order
+  text_cursor->qty = 0;
+  for (size_t s=editor_symbol_first(text_buffer, type, entity); s!=SIZE_MAX; s=text_buffer->symbols[s].next){
+    assert(text_cursor->qty < CURSOR_QTY_MAX);
+    text_cursor->pos[text_cursor->qty] = text_buffer->symbols[s].start + text_buffer->symbols[s].length;
+    text_cursor->qty += 1;
+  }
+  if (text_cursor->qty == 0){
+    editor_cursor_reset(text_cursor);
+  }
+  else{
+    editor_cursor_quicksort(text_cursor->pos, 0, text_cursor->qty - 1);
+  }
+  return selection_changed;
+}
+
+#endif
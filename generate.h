@@ -0,0 +1,241 @@
+#ifndef GENERATE_H
+#define GENERATE_H
+
+// random schedules for the benchmark and the solver verifier. a plan is kept as plain arrays so it can be shrunk
+// task by task, and written out in the editor's text format to go through the real parser
+
+// standard system files
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+// other files within this project
+#include "schedule.h"
+#include "editor.h"
+
+#define GENERATE_DAY_BASE 19359 // 2023-01-02, in days since the epoch
+
+enum GENERATE_FIXED {
+  GENERATE_FIXED_NONE,
+  GENERATE_FIXED_START,
+  GENERATE_FIXED_END
+};
+
+// shape of a generated schedule
+typedef struct Generate_Options{
+  size_t tasks;
+  size_t users; // 0 picks enough users for the task count
+  size_t depth; // layers of the prereq graph, 0 for about sqrt(tasks). width is tasks / depth
+  size_t fan_in; // most prereqs per task, each from an earlier layer
+  double fixed_density; // share of the first layer's tasks with a fixed date. the first task is always fixed
+  double no_sooner_density; // share of the other tasks with a no_sooner date
+  uint64_t seed;
+} Generate_Options;
+
+typedef struct Generate_Task{
+  uint64_t duration;
+  size_t prereqs[TASK_DEPENDENCIES_MAX]; // indices of earlier tasks
+  size_t prereq_qty;
+  size_t user;
+  uint8_t fixed; // enum GENERATE_FIXED
+  uint64_t fixed_day;
+  uint64_t no_sooner; // 0 for none
+} Generate_Task;
+
+typedef struct Generate_Plan{
+  Generate_Task* tasks;
+  size_t task_qty;
+  size_t user_qty;
+} Generate_Plan;
+
+
+uint64_t generate_random(uint64_t* state){
+  *state ^= *state << 13;
+  *state ^= *state >> 7;
+  *state ^= *state << 17;
+  return *state;
+}
+
+
+// users for a schedule of this size; asked for, or enough that nobody comes close to USER_TASKS_MAX
+size_t generate_users(Generate_Options* options){
+  size_t users = options->users;
+  if (users == 0){
+    users = options->tasks / 32 + 2;
+  }
+  return users;
+}
+
+
+// TRUE if a schedule of this shape fits in the model, otherwise say why not
+int generate_fits(Generate_Options* options, FILE* log){
+  size_t users = generate_users(options);
+  if ((options->tasks + users - 1) / users >= USER_TASKS_MAX){
+    fprintf(log, "[WARNING] skipping %lu tasks, %lu users would each have more than USER_TASKS_MAX (%d)\n", options->tasks, users, USER_TASKS_MAX);
+    return FALSE;
+  }
+  if (options->fan_in > TASK_DEPENDENCIES_MAX){
+    fprintf(log, "[WARNING] skipping, a fan in of %lu is over TASK_DEPENDENCIES_MAX (%d)\n", options->fan_in, TASK_DEPENDENCIES_MAX);
+    return FALSE;
+  }
+  return TRUE;
+}
+
+
+// a random plan. layered so there are no prereq loops, users are handed out evenly, and only first layer tasks get
+// fixed dates, so some schedule always exists. free with generate_plan_free()
+Generate_Plan* generate_plan(Generate_Options* options){
+  uint64_t state = options->seed * 2654435761u + 1;
+  size_t tasks = options->tasks;
+  size_t users = generate_users(options);
+  size_t depth = options->depth;
+  if (depth == 0){
+    depth = 1;
+    while (depth * depth < tasks){
+      depth += 1;
+    }
+  }
+  if (depth > tasks){
+    depth = tasks;
+  }
+  size_t width = (tasks + depth - 1) / depth;
+
+  Generate_Plan* plan = (Generate_Plan*) malloc(sizeof(Generate_Plan));
+  plan->tasks = (Generate_Task*) calloc(tasks + 1, sizeof(Generate_Task));
+  plan->task_qty = tasks;
+  plan->user_qty = users;
+  size_t* dependent_qty = (size_t*) calloc(tasks + 1, sizeof(size_t));
+  size_t* user_qty = (size_t*) calloc(users, sizeof(size_t));
+
+  for (size_t t=0; t<tasks; ++t){
+    Generate_Task* task = plan->tasks + t;
+    size_t layer = t / width;
+    task->duration = 1 + generate_random(&state) % 10;
+
+    // prereqs from the layers above, mostly the one right above. skip any that already have all the dependents they can
+    if ((layer > 0) && (options->fan_in > 0)){
+      size_t want = 1 + generate_random(&state) % options->fan_in;
+      for (size_t attempt=0; (attempt < 4*want) && (task->prereq_qty < want); ++attempt){
+        size_t from_layer = layer - 1;
+        if ((layer > 1) && (generate_random(&state) % 4 == 0)){
+          from_layer = generate_random(&state) % layer;
+        }
+        size_t p = from_layer * width + generate_random(&state) % width;
+        uint8_t taken = (dependent_qty[p] >= TASK_DEPENDENCIES_MAX);
+        for (size_t i=0; i<task->prereq_qty; ++i){
+          if (task->prereqs[i] == p){
+            taken = TRUE;
+          }
+        }
+        if (taken == FALSE){
+          task->prereqs[task->prereq_qty] = p;
+          task->prereq_qty += 1;
+          dependent_qty[p] += 1;
+        }
+      }
+    }
+
+    // the next user with room, starting from a random one
+    size_t u = generate_random(&state) % users;
+    while (user_qty[u] >= USER_TASKS_MAX - 1){
+      u = (u + 1) % users;
+    }
+    user_qty[u] += 1;
+    task->user = u;
+
+    if ((layer == 0) && ((t == 0) || ((double) (generate_random(&state) % 1000) < options->fixed_density * 1000))){
+      task->fixed = (generate_random(&state) % 4 == 0) ? GENERATE_FIXED_END : GENERATE_FIXED_START;
+      task->fixed_day = GENERATE_DAY_BASE + generate_random(&state) % 30;
+    }
+    else if ((double) (generate_random(&state) % 1000) < options->no_sooner_density * 1000){
+      task->no_sooner = GENERATE_DAY_BASE + generate_random(&state) % 60;
+    }
+  }
+
+  free(dependent_qty);
+  free(user_qty);
+  return plan;
+}
+
+
+void generate_plan_free(Generate_Plan* plan){
+  free(plan->tasks);
+  free(plan);
+}
+
+
+Generate_Plan* generate_plan_copy(Generate_Plan* plan){
+  Generate_Plan* copy = (Generate_Plan*) malloc(sizeof(Generate_Plan));
+  copy->tasks = (Generate_Task*) malloc((plan->task_qty + 1) * sizeof(Generate_Task));
+  memcpy(copy->tasks, plan->tasks, plan->task_qty * sizeof(Generate_Task));
+  copy->task_qty = plan->task_qty;
+  copy->user_qty = plan->user_qty;
+  return copy;
+}
+
+
+// take task t out of the plan, along with every prereq on it. later tasks move down one
+void generate_plan_remove(Generate_Plan* plan, size_t t){
+  memmove(plan->tasks + t, plan->tasks + t + 1, (plan->task_qty - t - 1) * sizeof(Generate_Task));
+  plan->task_qty -= 1;
+  for (size_t i=0; i<plan->task_qty; ++i){
+    Generate_Task* task = plan->tasks + i;
+    size_t kept = 0;
+    for (size_t p=0; p<task->prereq_qty; ++p){
+      if (task->prereqs[p] != t){
+        task->prereqs[kept] = task->prereqs[p] - (task->prereqs[p] > t);
+        kept += 1;
+      }
+    }
+    task->prereq_qty = kept;
+  }
+}
+
+
+// the plan in the editor's text format. returns the text, caller frees
+char* generate_plan_text(Generate_Plan* plan, size_t* text_length){
+  char* text = (char*) malloc(plan->task_qty * (160 + TASK_DEPENDENCIES_MAX * 16) + 1);
+  char* out = text;
+  char date[11];
+  for (size_t t=0; t<plan->task_qty; ++t){
+    Generate_Task* task = plan->tasks + t;
+    out += sprintf(out, "t%lu {\n", t);
+    out += sprintf(out, "  duration: %lu\n", task->duration);
+    if (task->prereq_qty > 0){
+      out += sprintf(out, "  prereq: ");
+      for (size_t i=0; i<task->prereq_qty; ++i){
+        out += sprintf(out, "%st%lu", (i > 0) ? ", " : "", task->prereqs[i]);
+      }
+      out += sprintf(out, "\n");
+    }
+    out += sprintf(out, "  user: u%lu\n", task->user);
+    if (task->fixed == GENERATE_FIXED_START){
+      text_append_date(date, task->fixed_day);
+      out += sprintf(out, "  fixed_start: %.10s\n", date);
+    }
+    else if (task->fixed == GENERATE_FIXED_END){
+      text_append_date(date, task->fixed_day);
+      out += sprintf(out, "  fixed_end: %.10s\n", date);
+    }
+    if (task->no_sooner > 0){
+      text_append_date(date, task->no_sooner);
+      out += sprintf(out, "  no_sooner: %.10s\n", date);
+    }
+    out += sprintf(out, "}\n");
+  }
+  *text_length = out - text;
+  return text;
+}
+
+
+// a buffer sized for the whole plan up front, and room for editor_text_from_data() to write it back out, so the
+// benchmark doesn't time the buffer growing
+Text_Buffer* generate_buffer_create(char* text, size_t text_length, size_t task_qty){
+  Text_Buffer* tb = editor_buffer_create(2 * text_length + 64 * task_qty + 1, 2 * text_length + 1);
+  memcpy(tb->text, text, text_length);
+  editor_buffer_written(tb, text_length);
+  return tb;
+}
+
+#endif
@@ -26,6 +26,57 @@ uint8_t keybind_global_file_reload(SDL_Event evt){
   return FALSE;
 }
 
+uint8_t keybind_global_solver_cycle(SDL_Event evt){
+  if (evt.type == SDL_KEYDOWN && evt.key.keysym.sym == SDLK_F6){
+    return TRUE;
+  }
+  return FALSE;
+}
+
+uint8_t keybind_global_incremental_toggle(SDL_Event evt){
+  if (evt.type == SDL_KEYDOWN && evt.key.keysym.sym == SDLK_F7){
+    return TRUE;
+  }
+  return FALSE;
+}
+
+uint8_t keybind_global_time_budget_cycle(SDL_Event evt){
+  if (evt.type == SDL_KEYDOWN && evt.key.keysym.sym == SDLK_F8){
+    return TRUE;
+  }
+  return FALSE;
+}
+
+uint8_t keybind_global_stats_toggle(SDL_Event evt){
+  if (evt.type == SDL_KEYDOWN && evt.key.keysym.sym == SDLK_F9 && !(SDL_GetModState() & KMOD_SHIFT)){
+    return TRUE;
+  }
+  return FALSE;
+}
+
+uint8_t keybind_global_stats_dump(SDL_Event evt){
+  if (evt.type == SDL_KEYDOWN && evt.key.keysym.sym == SDLK_F9 && SDL_GetModState() & KMOD_SHIFT){
+    return TRUE;
+  }
+  return FALSE;
+}
+
+uint8_t keybind_global_undo(SDL_Event evt){
+  if (evt.type == SDL_KEYDOWN && evt.key.keysym.sym == SDLK_z && SDL_GetModState() & KMOD_CTRL && !(SDL_GetModState() & KMOD_SHIFT)){
+    return TRUE;
+  }
+  return FALSE;
+}
+
+uint8_t keybind_global_redo(SDL_Event evt){
+  if (evt.type == SDL_KEYDOWN && SDL_GetModState() & KMOD_CTRL){
+    if ((evt.key.keysym.sym == SDLK_y) || (evt.key.keysym.sym == SDLK_z && SDL_GetModState() & KMOD_SHIFT)){
+      return TRUE;
+    }
+  }
+  return FALSE;
+}
+
 uint8_t keybind_viewport_mode_toggle(SDL_Event evt){
   if (evt.key.keysym.sym == SDLK_TAB && evt.type == SDL_KEYDOWN){
     return TRUE;
@@ -42,6 +93,19 @@ uint8_t keybind_editor_multicursor_deselect(SDL_Event evt){
   return FALSE;
 }
 
+// keys that only change the text at the cursors, they're batched up per frame
+uint8_t keybind_editor_text_edit(SDL_Event evt){
+  if (evt.type == SDL_KEYDOWN){
+    if ((evt.key.keysym.sym == SDLK_BACKSPACE) || (evt.key.keysym.sym == SDLK_DELETE) || (evt.key.keysym.sym == SDLK_RETURN)){
+      return TRUE;
+    }
+  }
+  if ((evt.type == SDL_TEXTINPUT) && !(SDL_GetModState() & KMOD_CTRL)){
+    return TRUE;
+  }
+  return FALSE;
+}
+
 uint8_t keybind_editor_symbol_rename(SDL_Event evt){
   if (evt.key.keysym.sym == SDLK_F2 && evt.type == SDL_KEYDOWN){
     return TRUE;
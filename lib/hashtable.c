@@ -73,7 +73,7 @@ int hash_table_insert(HashTable* ht, char* str, void* data){
     // now do the insertion work if a new entry
     if (ht->data[index].value == NULL){
         // allocate memory to store the key string long term
-        char* key = (char*) malloc( (string_length) * sizeof(char));
+        char* key = (char*) malloc( (string_length + 1) * sizeof(char));
         strcpy(key, str);
 
         // now store information into the hash table
@@ -16,6 +16,7 @@
 
 // other files within this project
 #include "schedule.h"
+#include "editor.h"
 #include "keyboard_bindings.h"
 #include "lib/hashtable.h"
 #include "lib/font_bitmap.h"
@@ -32,748 +33,9 @@ enum VIEWPORT_TYPES {
   VIEWPORT_RENAME
 };
 
-
-
-// viewport-editor related
-#define LINE_MAX_LENGTH 512
-#define EDITOR_BUFFER_LENGTH 1024
-#define EDITOR_LINES_MAX 1024
-
 // viewport-display related
 #define TASK_DISPLAY_LIMIT 1024
 
-///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-void tasks_init(Task_Memory* task_memory, User_Memory* user_memory){
-  task_memory->allocation_total = 64;
-  task_memory->allocation_used = 0;
-  task_memory->tasks = (Task*) malloc(task_memory->allocation_total * sizeof(Task));
-  task_memory->hashtable = hash_table_create(HT_TASKS_MAX, HT_FREE_KEY);
-
-  for (size_t i=0; i<task_memory->allocation_total; ++i){
-    task_memory->tasks[i].trash = TRUE;
-  }
-  task_memory->editor_visited = (uint8_t*) malloc(task_memory->allocation_total * sizeof(uint8_t));
-  memset(task_memory->editor_visited, 0, task_memory->allocation_total);
-  task_memory->temp_status = (uint8_t*) malloc(task_memory->allocation_total * sizeof( *task_memory->temp_status));
-  printf("Task init() complete for %ld tasks\n", task_memory->allocation_total);
-
-  status_color_init();
-
-  user_memory->allocation_total = 8;
-  user_memory->allocation_used = 0;
-  user_memory->users = (User*) malloc(user_memory->allocation_total * sizeof(User));
-  for (size_t i=0; i<user_memory->allocation_total; ++i){
-    user_memory->users[i].trash = TRUE;
-  }
-  user_memory->hashtable = hash_table_create(HT_USERS_MAX, HT_FREE_KEY);
-  user_memory->editor_visited = (uint8_t*) malloc(user_memory->allocation_total * sizeof(uint8_t));
-  memset(user_memory->editor_visited, 0, user_memory->allocation_total);
-}
-
-
-void tasks_free(Task_Memory* task_memory, User_Memory* user_memory){
-  printf("[STATUS] FREEING TASK TABLE\n");
-  hash_table_print(task_memory->hashtable);
-  hash_table_destroy(task_memory->hashtable);
-  free(task_memory->tasks);
-  free(task_memory->editor_visited);
-  free(task_memory->temp_status);
-
-  hash_table_print(user_memory->hashtable);
-  hash_table_destroy(user_memory->hashtable); 
-  free(user_memory->users);
-  free(user_memory->editor_visited);
-}
-
-
-// grow memory as needed to hold allocated tasks
-// don't shrink - avoid having to search and move active nodes into lower memory space in realtime
-// if needed user could save and restart to reduce memory footprint
-void task_memory_management(Task_Memory* tm){
-  if (tm->allocation_used >= tm->allocation_total){
-    printf("[CAUTION] TASK MEMORY MANAGEMENT ACTIVATED, INCREASING MEMORY ALLOCATIONS\n");
-    uint64_t task_allocation_old = tm->allocation_total;
-    tm->allocation_total *= 1.5;
-    tm->tasks = (Task*) realloc(tm->tasks, tm->allocation_total * sizeof(Task));
-    tm->editor_visited = (uint8_t*) realloc(tm->editor_visited, tm->allocation_total * sizeof(uint8_t));
-    tm->temp_status = (uint8_t*) realloc(tm->temp_status, tm->allocation_total * sizeof( *tm->temp_status));
-
-    for (size_t i=task_allocation_old; i<tm->allocation_total; ++i){
-      tm->tasks[i].trash = TRUE;
-      tm->editor_visited[i] = FALSE;
-    }
-  }
-
-  // TODO some way to update has task_names_ht size.. would need to re-index all tasks :(
-}
-
-
-// only allowed to create a task in edit mode
-Task* task_create(Task_Memory* task_memory, char* task_name, size_t task_name_length){
-  Task* tasks = task_memory->tasks;
-
-  // find an empty slot to use for the task
-  do {
-    task_memory->last_created = (task_memory->last_created + 1) % task_memory->allocation_total;
-  } while (tasks[task_memory->last_created].trash == FALSE);
-  task_memory->allocation_used += 1;
-
-  Task* task = (tasks + task_memory->last_created);
-
-  // zero everything there. also brings mode out of trash mode
-  memset((void*) task, 0, sizeof(Task));
-  task->trash = FALSE;
-  task->task_name_length = task_name_length;
-  task->mode_edit = TRUE; 
-  task->mode_edit_temp = FALSE;
-  
-  // add to hash table
-  char* name = (char*) malloc(task_name_length+1);
-  memcpy(name, task_name, task_name_length);
-  name[task_name_length] = '\0';
-  hash_table_insert(task_memory->hashtable, name, (void*) task);
-  task->task_name = name;
-
-  return task;
-}
-
-
-Task* task_get(Task_Memory* task_memory, char* task_name, int task_name_length){
-  // use the hash table to find a pointer to the task based on the string name the user gives
-  // return NULL if the task does not exist and needs to be created
-  char name[128]; // TODO
-  assert(task_name_length < 128);
-  memcpy(name, task_name, task_name_length);
-  name[task_name_length] = '\0';
-  Task* task = (Task*) hash_table_get(task_memory->hashtable, name);
-  return task;
-}
-
-// check if the given user is already assigned to the given task
-uint8_t task_user_has(Task* task, User* user){
-  uint8_t result = FALSE;
-  for(size_t i=0; i<task->user_qty; ++i){
-    if (task->users[i] == user){
-      result = TRUE;
-    }
-  }
-  return result;
-}
-
-
-// add user to task if user is not already there
-void task_user_add(Task* task, User* user){
-  assert(task->user_qty < TASK_USERS_MAX);
-  assert(user->task_qty < USER_TASKS_MAX);
-
-  if (task_user_has(task, user) == FALSE){
-    task->users[task->user_qty] = user;
-    task->user_qty += 1;
-
-    user->tasks[user->task_qty] = task;
-    user->task_qty += 1;
-  }
-}
-
-
-// edits task struct to remove user pointer, and user struct to remove task pointer
-void task_user_remove(Task* task, User* user){
-  size_t id = 0;
-
-  // find the user pointer in the task struct
-  uint8_t found = 0;
-  for(size_t i=0; i<task->user_qty; ++i){
-    if (task->users[i] == user){
-      id = i;
-      found = 1;
-      break;
-    }
-  }
-
-  // now shuffle down all the remaining users, update the qty
-  if (found == 1){
-    for (size_t i=id; i<task->user_qty-1; ++i){
-      task->users[i] = task->users[i+1];
-    }
-    task->user_qty -= 1;
-  }
-
-  // now remove the task pointer from the user struct
-  uint8_t found2 = 0;
-  for(size_t i=0; i<user->task_qty; ++i){
-    if (user->tasks[i] == task){
-      id = i;
-      found2 = 1;
-      break;
-    }
-  }
-
-  // and shuffle down the remaining users
-  if (found2 == 1){
-    for (size_t i=id; i<user->task_qty; ++i){
-      user->tasks[i] = user->tasks[i+1];
-    }
-    user->task_qty -= 1;
-  }
-
-  assert(found == found2);
-}
-
-
-// look at a task, remove users you expected to see but did not
-void task_user_remove_unvisited(Task* task, User_Memory* user_memory){
-  if (task->user_qty > 0){
-    for (size_t u=task->user_qty; u>0; u--){
-      User* user = task->users[u-1];
-      size_t uindex = user - user_memory->users;
-      if (user_memory->editor_visited[uindex] == FALSE){
-        task_user_remove(task, user);
-      }
-    }
-  }
-}
- 
-
-void task_destroy(Task_Memory* task_memory, Task* task){
-  assert(task->trash == FALSE); // don't try and remove already-removed tasks
-  task->trash = TRUE;
-  if (task_memory->allocation_used > 0){
-    task_memory->allocation_used -= 1;
-  }
-  printf("REMOVING tasks.name=%s..\n", task->task_name);
-  hash_table_remove(task_memory->hashtable, task->task_name);
-
-  for (size_t u=0; u<task->user_qty; ++u){
-    task_user_remove(task, task->users[u]);
-  }
-}
-
-
-void task_dependents_find_all(Task_Memory* task_memory){
-  Task* tasks = task_memory->tasks;
-
-  // clear previous info
-  for (size_t t=0; t<task_memory->allocation_total; ++t){
-    tasks[t].dependent_qty = 0;
-  }
-
-  // search and add
-  for( size_t t=0; t<task_memory->allocation_total; ++t){
-    if (tasks[t].trash == FALSE){
-      for (size_t i=0; i<tasks[t].prereq_qty; ++i){
-        Task* prereq = tasks[t].prereqs[i];
-        prereq->dependents[prereq->dependent_qty] = tasks+t;
-        prereq->dependent_qty += 1;
-      }
-    }
-  }
-} 
-
-
-void task_name_generate(Task_Memory* task_memory, Task* base, char* result_name, int* result_length){
-  int i = 0;
-  Task* exists = NULL;
-  do {
-    ++i;
-    *result_length = sprintf(result_name, "%s%d", base->task_name, i);
-    exists = task_get(task_memory, result_name, *result_length);
-    if (i > 999){
-      printf("[ERROR] COULD NOT FIND A VALID NEW TASK NAME\n");
-      assert(0);
-    }
-  } while (exists != NULL);
-}
-
-///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-
-void user_memory_management(User_Memory* um){
-  if (um->allocation_used >= um->allocation_total){
-    printf("[CAUTION] USER MEMORY MANAGEMENT ACTIVATED, INCREASING MEMORY ALLOCATIONS\n");
-    uint64_t user_allocation_old = um->allocation_total;
-    um->allocation_total *= 1.5;
-    um->users = (User*) realloc(um->users, um->allocation_total * sizeof(User));
-
-    for (size_t i=user_allocation_old; i<um->allocation_total; ++i){
-      um->users[i].trash = TRUE;
-      um->editor_visited[i] = FALSE;
-    }
-  }
-}
-
-
-User* user_create(User_Memory* user_memory, char* user_name, size_t name_length){
-  user_memory_management(user_memory);
-  // find an empty user slot to use
-  do {
-    user_memory->last_created = (user_memory->last_created + 1) % user_memory->allocation_total;
-  } while(user_memory->users[user_memory->last_created].trash == FALSE);
-  User* user = user_memory->users + user_memory->last_created;
-  user_memory->allocation_used += 1;
-
-  // zero everything there
-  memset((void*) user, 0, sizeof(User));
-  user->trash = FALSE; 
-  user->name_length = name_length;
-
-  char* name = (char*) malloc(name_length+1);
-  memcpy(name, user_name, name_length);
-  name[name_length] = '\0';
-  hash_table_insert(user_memory->hashtable, name, (void*) user);
-  user->name = name;
-
-  return user;
-}
-
-
-User* user_get(User_Memory* user_memory, char* user_name, int user_name_length){
-  // use the hash table to find a pointer to the user based on the string given
-  // return NULL if does not exist and needs to be created
-  char name[128]; // TODO
-  memcpy(name, user_name, user_name_length);
-  name[user_name_length] = '\0';
-  User* user = (User*) hash_table_get(user_memory->hashtable, name);
-  return user;
-}
-
-///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-// return NULL, result_length=0 
-char* string_strip(int* result_length, char* str, int str_length){
-  // look at the front, cut off bad characters
-  char* result = str; 
-  *result_length = str_length;
-  while (isalnum(result[0]) == 0){
-    ++result;
-    *result_length -= 1;
-    if (*result_length == 0){
-      return NULL;
-    }
-  }
-
-  // seek to the end, search backwards to cut off bad characters
-  char* end = result + *result_length - 1;
-  while (isalnum(end[0]) == 0){
-    --end;
-    *result_length -= 1;
-    if (*result_length == 0){
-      return NULL;
-    }
-  }
-
-  return result;
-}
-
-
-// scrub through tasks, remove any that you expected to see but did not
-void editor_tasks_cleanup(Task_Memory* task_memory){
-  Task* tasks = task_memory->tasks;
-  for (size_t i=0; i<task_memory->allocation_total; ++i){
-    if (tasks[i].trash == FALSE){ // if node is NOT trash
-      if (tasks[i].mode_edit == TRUE){
-
-        // if we did not visit the node this time parsing the text
-        if (task_memory->editor_visited[i] == FALSE){ 
-          task_destroy(task_memory, tasks+i);
-        }
-      }
-    }
-  }
-
-  hash_table_print(task_memory->hashtable);
-}
-
-
-// scrub through users, remove any that have zero assigned tasks (user->task_qty = 0)
-void editor_users_cleanup(User_Memory* user_memory){
-  User* users = user_memory->users;
-
-  for (size_t i=0; i<user_memory->allocation_total; ++i){
-    if(users[i].trash == FALSE){
-      if (users[i].task_qty == 0){
-
-        users[i].trash = TRUE;
-        if (user_memory->allocation_used > 0){
-          user_memory->allocation_used -= 1;
-        }
-        printf("REMOVING users[%ld].name=%s..\n", i, users[i].name);
-
-        hash_table_remove(user_memory->hashtable, users[i].name);
-      }
-    }
-  }
-  hash_table_print(user_memory->hashtable);
-}
-
-
-void editor_parse_task_detect(Task_Memory* task_memory, Text_Buffer* text_buffer){
-  printf("[STATUS] PASS 1 editor_parse_task_detect()\n");
-  char* text_end = text_buffer->text + text_buffer->length;
-  char* line_start = text_buffer->text;
-  char* line_end;
-  int line_working_length = 0;
-  Task* task = NULL;
-  int line = 0;
-  while (line_start < text_end){
-    line_end = memchr(line_start, (int) '\n', text_end - line_start);
-    if (line_end == NULL){
-      if (text_end - line_start > 0){
-        line_end = text_end;
-      }
-      else{
-        break;
-      }
-    }
-    line_working_length = line_end - line_start;
-    if (line_working_length == 0){
-      ++line_start;
-      text_buffer->line_task[line] = task;
-      ++line;
-      continue;
-    }
-
-    if (memchr(line_start, (int) '{', line_working_length) != NULL){
-      // TODO check, prevent duplicate task names
-      int task_name_length;
-      char* task_name = string_strip(&task_name_length, line_start, line_working_length);
-      if (task_name_length > 0){
-        printf("detected task: '%.*s'\n", task_name_length, task_name);
-
-        // now get a pointer to the task
-        task = task_get(task_memory, task_name, task_name_length);
-        if (task == NULL){
-          task = task_create(task_memory, task_name, task_name_length); // TODO is create the right action? maybe parse and then decide? 
-          printf("created task. allocations: %ld of %ld\n", task_memory->allocation_used, task_memory->allocation_total);
-        }
-
-        // mark task as visited
-        task_memory->editor_visited[task - task_memory->tasks] = TRUE;
-      }
-    }
-
-    line_start = line_end + 1;
-
-    text_buffer->line_task[line] = task;
-    ++line;
-  }
-}
-
-
-uint64_t editor_parse_date(char* value_str, int value_str_length){
-  // get the current time to initialize some values of timeinfo with time zone and stuff
-  time_t now; 
-  time(&now);
-  struct tm* timeinfo = gmtime(&now);
-
-  char* line_end = value_str + value_str_length;
-
-  // separate year from month
-  char* split1 = memchr(value_str, (int) '-', value_str_length);
-  if (split1 != NULL){
-    timeinfo->tm_year = strtol(value_str, &split1, 10);
-
-    // separate month from day
-    char* split2 = memchr(split1+1, (int) '-', value_str_length - (split1 - value_str) - 1);
-    if (split2 != NULL){
-      timeinfo->tm_mon = strtol(split1+1, &split2, 10);
-      timeinfo->tm_mday = strtol(split2+1, &line_end, 10);
-    }
-    // can't find a day, use start of the month as default
-    else{
-      timeinfo->tm_mon = strtol(split1+1, &line_end, 10);
-      timeinfo->tm_mday = 1;
-    }
-  }
-
-  // can't find a month (or day), use start as default
-  else{
-    timeinfo->tm_year = strtol(value_str, &line_end, 10);
-    timeinfo->tm_mon = 1;
-    timeinfo->tm_mday = 1;
-  }
-
-  // now convert that into epoch time..
-  timeinfo->tm_year -= 1900; // years are 1900-indexed
-  timeinfo->tm_mon -= 1; // months are zero-indexed
-  timeinfo->tm_sec = 0;
-  timeinfo->tm_min = 0;
-  timeinfo->tm_hour = 0;
-  time_t date_epoch = mktime(timeinfo);
-  assert(date_epoch != -1);
-
-  // date_epoch is seconds since epoch. divide to get days since epoch
-  uint64_t day = (uint64_t) date_epoch / 86400;
-
-  //printf("Year: %d\n", timeinfo.tm_year);
-  //printf("Month: %d\n", timeinfo.tm_mon);
-  //printf("Day: %d\n", timeinfo.tm_mday);
-
-  return day;
-}
-
-
-char* text_append_date(char* text_output, uint64_t day){
-  // convert days since epoch to second since epoch
-  time_t date_epoch = day * 86400;
-
-  // GM time is UTC (GMT timezome - ignoring timezones)
-  struct tm* timeinfo = gmtime(&date_epoch);
-
-  size_t result = strftime(text_output, 11, "%F", timeinfo);
-  assert(result != 0);
-
-  return text_output+10;
-}
-
-
-// comma to separate values in a list
-void editor_parse_propertyline(Task_Memory* task_memory, User_Memory* user_memory, Task* task, char* line_start, int line_working_length, Text_Buffer* text_buffer, Text_Cursor* text_cursor){
-  char* line_end = line_start + line_working_length;
-  // split into property and value parts. split on ':'
-  char* split = memchr(line_start, (int) ':', line_working_length);
-  int property_str_length;
-  char* property_str = string_strip(&property_str_length, line_start, split - line_start);
-  if (property_str_length == 0){
-    return;
-  }
-
-  int value_str_length;
-  char* value_str = string_strip(&value_str_length, split, line_end - split);
-
-  printf("(task %s) add property='%.*s'  value='%.*s'\n", task->task_name, property_str_length, property_str, value_str_length, value_str);
-  if (value_str_length == 0){
-    return;
-  }
-
-  if (memcmp(property_str, "user", 4) == 0){
-    // split on ','
-    char* property_split_start = value_str;
-    char* property_split_end = value_str;
-
-    while(property_split_start < line_end){
-      property_split_end = memchr(property_split_start, (int) ',', line_end - property_split_start);
-      if (property_split_end == NULL){
-        property_split_end = line_end;
-      }
-
-      // parse what you find
-      int value_length;
-      char* value = string_strip(&value_length, property_split_start, property_split_end - property_split_start);
-      if (value_length > 0){
-        User* user = user_get(user_memory, value, value_length);
-        if (user == NULL){
-          printf("user: '%.*s' NEW!\n", value_length, value);
-          user = user_create(user_memory, value, value_length); 
-        }
-        else{
-          printf("user: '%.*s' EXISTING\n", value_length, value);
-        }
-        user->trash = FALSE;
-        user->mode_edit = TRUE;
-        user_memory->editor_visited[user - user_memory->users] = TRUE;
-
-        // assign to the task, if it is not already there
-        task_user_add(task, user);
-
-        // mark in cursor TODO MULTICURSOR
-        if ((text_cursor->pos[0] >= property_split_start - text_buffer->text) && (text_cursor->pos[0] <= property_split_end - text_buffer->text)){
-          text_cursor->entity_type = TEXTCURSOR_ENTITY_USER;
-          text_cursor->entity = (void*) user;
-          printf("  [CURSOR DETECT] says cursor on task '%s', user '%s'\n", task->task_name, user->name);
-        }
-      }
-
-      property_split_start = property_split_end + 1;
-    }
-  }
-
-  else if(memcmp(property_str, "prereq", 6) == 0){
-    printf("parsing prerequisites\n");
-    char* property_split_start = value_str;
-    char* property_split_end = value_str;
- 
-    while (property_split_start < line_end){
-      property_split_end = memchr(property_split_start, (int) ',', line_end - property_split_start);
-      if (property_split_end == NULL){
-        property_split_end = line_end;
-      }
-
-      // parse what you find
-      int value_length;
-      char* value = string_strip(&value_length, property_split_start, property_split_end - property_split_start);
-      if (value_length > 0){
-        Task* prereq = task_get(task_memory, value, value_length);
-        if (prereq != NULL){
-          task->prereqs[task->prereq_qty] = prereq;
-          task->prereq_qty += 1;
-
-          // mark in cursor TODO MULTICURSOR
-          if ((text_cursor->pos[0] >= property_split_start - text_buffer->text) && (text_cursor->pos[0] <= property_split_end - text_buffer->text)){
-            text_cursor->entity_type = TEXTCURSOR_ENTITY_PREREQ;
-            text_cursor->entity = (void*) prereq;
-            printf("  [CURSOR DETECT] says cursor on task '%s', prereq '%s'\n", task->task_name, prereq->task_name);
-          }
-        }
-        else{
-          // TODO something when dependencies don't exist
-        }
-      }
-
-      property_split_start = property_split_end + 1;
-    }
-  }
-
-  else if(memcmp(property_str, "duration", 8) == 0){
-    int duration = atoi(value_str);
-    task->day_duration = duration;
-    task->schedule_constraints |= SCHEDULE_CONSTRAINT_DURATION;
-  }
-  else if(memcmp(property_str, "fixed_start", 11) == 0){
-    task->schedule_constraints |= SCHEDULE_CONSTRAINT_START;
-    task->day_start = editor_parse_date(value_str, value_str_length);
-  }
-  else if(memcmp(property_str, "fixed_end", 9) == 0){
-    task->schedule_constraints |= SCHEDULE_CONSTRAINT_END;
-    task->day_end = editor_parse_date(value_str, value_str_length);
-  }
-
-  else if(memcmp(property_str, "color", 5) == 0){
-    int color = atoi(value_str);
-    if ((color > 9) || (color < 0)){
-      color = 0;
-    }
-    task->status_color = color;
-  }
-
-  else{
-    printf("[WARNING] PROPERTY %.*s NOT RECOGNIZED\n", property_str_length, property_str);
-  }
-
-}
- 
-
-// in edit mode, lock the Activity_Node ids that are being shown in the edit pane.
-// modify the full network directly. automatically delete/re-add everything being edited in edit mode. assume all those nodes selected are trashed and revised. 
-// how to balance reparsing everything at 100Hz and only reparsing what is needed? maybe use the cursor to direct efforts? only reparse from scratch the node the cursor is in
-void editor_parse_text(Task_Memory* task_memory, User_Memory* user_memory, Text_Buffer* text_buffer, Text_Cursor* text_cursor){
-  uint64_t cpu_timer_start = SDL_GetPerformanceCounter();
-
-  char* text_start = text_buffer->text;
-  size_t text_length = text_buffer->length;
-  char* text_end = text_start + text_length;
-  Task* tasks = task_memory->tasks;
-
-  // track difference betweeen seen [tasks, users] and expected to see tasks
-  // if you don't see items that you expect to.. need to remove those!
-  for (size_t i=0; i<task_memory->allocation_total; ++i){
-    task_memory->editor_visited[i] = FALSE;
-  }
-  for (size_t i=0; i<user_memory->allocation_total; ++i){
-    user_memory->editor_visited[i] = FALSE;
-  }
-  for (size_t i=0; i<task_memory->allocation_total; ++i){
-    if (tasks[i].mode_edit == TRUE){
-      tasks[i].prereq_qty = 0; // TODO is there a better way to do this? using mode_edit and cleanup?
-      //tasks[i].user_qty = 0;
-    }
-  }
-  text_cursor->entity_type = TEXTCURSOR_ENTITY_NONE;
-  text_cursor->entity = NULL;
-
-  // PASS 1 - just add/remove tasks, mark them as visited. new tasks are marked edit_mode = TRUE
-  editor_parse_task_detect(task_memory, text_buffer);
-
-  // reset some properties for all tasks in the editor
-  for (size_t t=0; t<task_memory->allocation_total; ++t){
-    if (task_memory->tasks[t].mode_edit == TRUE){
-      task_memory->tasks[t].schedule_constraints = 0;
-    }
-  }
-
-  // PASS 2 - all task properties, now you can scrub dependencies
-  // read one line at a time
-  printf("[STATUS] PASS 2 working through the properties\n");
-  char* line_start = text_start;
-  char* line_end;
-  int line_working_length = 0;
-  Task* task = NULL;
-  while (line_start < text_end){
-    line_end = memchr(line_start, (int) '\n', text_end - line_start);
-    if (line_end == NULL){
-      if (text_end - line_start > 0){
-        line_end = text_end;
-      }
-      else{
-        break;
-      }
-    }
-    line_working_length = line_end - line_start;
-    if (line_working_length == 0){
-      ++line_start;
-      continue;
-    }
-
-    // task open
-    if (memchr(line_start, (int) '{', line_working_length) != NULL){
-      // cleanup old tasks that haven't been closed properly yet
-      if (task != NULL){
-        task_user_remove_unvisited(task, user_memory);
-        task = NULL;
-      }
-
-      int task_name_length;
-      char* task_name = string_strip(&task_name_length, line_start, line_working_length);
-      if (task_name_length > 0){
-        task = task_get(task_memory, task_name, task_name_length);
-        assert( task != NULL);
-      }
-
-      // TODO MULTICURSOR
-      if ((text_cursor->pos[0] >= line_start - text_start) && (text_cursor->pos[0] < line_end - text_start)){
-        printf("cursor on line creating task '%s'\n", task->task_name);
-        text_cursor->entity_type = TEXTCURSOR_ENTITY_TASK;
-        text_cursor->entity = (void*) task;
-      }
-    }
-
-    // task close
-    else if (memchr(line_start, (int) '}', line_working_length) != NULL){
-      if (task != NULL){
-        printf("detected '}' ... cleaning up / closing task '%s'\n", task->task_name);
-        task_user_remove_unvisited(task, user_memory);
-        task = NULL;
-      }
-    }
-
-    // property line
-    else if(memchr(line_start, (int) ':', line_working_length) != NULL){
-      editor_parse_propertyline(task_memory, user_memory, task, line_start, line_working_length, text_buffer, text_cursor);
-    }
-
-    // advance to the next line
-    line_start = line_end + 1;
-  } // done going through lines
-
-  // text at the top level creates activities with that name
-  // open bracket increases to the next level
-  // text at the next level causes a lookup for a struct member. colon separator
-
-  // cleanup tasks that are in the progress of being written and don't have a close brace yet
-  if (task != NULL){
-    task_user_remove_unvisited(task, user_memory);
-    task = NULL;
-  }
-
-  editor_tasks_cleanup(task_memory);
-  editor_users_cleanup(user_memory);
-
-  task_dependents_find_all(task_memory);
-
-  uint64_t cpu_timer_end = SDL_GetPerformanceCounter();
-  double cpu_timer_elapsed = ((double) cpu_timer_end - cpu_timer_start) / ((double) SDL_GetPerformanceFrequency());
-  printf("[STATUS] Finished parsing text this round, time: %.3lf ms\n", cpu_timer_elapsed*1000);
-
-  // TODO add better error handling warning stuff
-}
-
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 void sdl_startup(SDL_Window** win, SDL_Renderer** render){
@@ -894,18 +156,42 @@ void draw_dependency_curve(SDL_Renderer* render, int start_x, int start_y, int e
 
 
 // draw the schedule time in the lower right corner of the display viewport
-void draw_time_stats(SDL_Renderer* render, SDL_Rect viewport_display, Schedule_Event_List* schedule, Font* font){
+void draw_time_stats(SDL_Renderer* render, SDL_Rect viewport_display, Schedule_Event_List* schedule, Font* font, uint8_t stale){
 
   SDL_Rect dst = {5, 5, viewport_display.w - 5, viewport_display.h - 5};
   SDL_Color color = {0, 0, 0, 0xFF};
   
   // time stats
-  char time_string[32];
-  int time_string_length = sprintf(time_string, "Solve time: %.1lf ms", schedule->solve_time_ms);
+  char time_string[256];
+  int time_string_length = sprintf(time_string, "%s", schedule_solver_name(schedule->solver));
+  if (schedule->solved == TRUE){
+    time_string_length += sprintf(time_string + time_string_length, " | Best: %lu days", schedule->day_duration);
+    if (schedule->optimal == TRUE){
+      time_string_length += sprintf(time_string + time_string_length, " (optimal)");
+    }
+    else if (schedule->timed_out == TRUE){
+      time_string_length += sprintf(time_string + time_string_length, " (time limit)");
+    }
+  }
+  time_string_length += sprintf(time_string + time_string_length, " | Solve time: %.1lf ms", schedule->solve_time_ms);
+  if (schedule->repaired_qty > 0){
+    time_string_length += sprintf(time_string + time_string_length, " | Repaired: %lu tasks by list", schedule->repaired_qty);
+  }
+  else{
+    time_string_length += sprintf(time_string + time_string_length, " | Nodes: %lu, pruned: %lu", schedule->search_nodes, schedule->search_prunes);
+  }
   fontmap_render_string(render, dst, font, color, time_string, time_string_length, FONT_ALIGN_H_RIGHT | FONT_ALIGN_V_BOTTOM);
   
-  // status solve yes no
-  if (schedule->solved == TRUE){
+  // status solve yes no. stale while the solver is still catching up with the text
+  if (stale == TRUE){
+    if (schedule->solved == TRUE){
+      fontmap_render_string(render, dst, font, color, "Schedule: Solved (stale, solving...)", 37, FONT_ALIGN_H_LEFT | FONT_ALIGN_V_BOTTOM);
+    }
+    else{
+      fontmap_render_string(render, dst, font, color, "Schedule: Failed (stale, solving...)", 37, FONT_ALIGN_H_LEFT | FONT_ALIGN_V_BOTTOM);
+    }
+  }
+  else if (schedule->solved == TRUE){
     fontmap_render_string(render, dst, font, color, "Schedule: Solved", 17, FONT_ALIGN_H_LEFT | FONT_ALIGN_V_BOTTOM);
   }
   else{
@@ -914,6 +200,29 @@ void draw_time_stats(SDL_Renderer* render, SDL_Rect viewport_display, Schedule_E
 
 }
 
+// the expanded status bar. where the last solve spent its effort, above the time stats
+void draw_solve_stats(SDL_Renderer* render, SDL_Rect viewport_statusbar, Schedule_Event_List* schedule, Font* font){
+  SDL_Rect dst = {5, 5, viewport_statusbar.w - 5, font->map.max_height};
+  SDL_Color color = {0, 0, 0, 0xFF};
+  Schedule_Stats* stats = &schedule->stats;
+  char stats_string[256];
+  int stats_string_length;
+
+  stats_string_length = sprintf(stats_string, "Nodes: %lu | Pruned: %lu | Backtracks: %lu | Failed pushes: %lu | Max depth: %lu", schedule->search_nodes, schedule->search_prunes, stats->backtracks, stats->failed_pushes, stats->depth_max);
+  fontmap_render_string(render, dst, font, color, stats_string, stats_string_length, FONT_ALIGN_H_LEFT | FONT_ALIGN_V_TOP);
+  dst.y += font->map.max_height;
+
+  stats_string_length = sprintf(stats_string, "Conflict checks: %lu | Shift iterations: %lu | Improvements: %lu", stats->conflict_checks, stats->shift_iterations, schedule->improvements);
+  fontmap_render_string(render, dst, font, color, stats_string, stats_string_length, FONT_ALIGN_H_LEFT | FONT_ALIGN_V_TOP);
+  dst.y += font->map.max_height;
+
+  stats_string_length = sprintf(stats_string, "Phases (ms):");
+  for (size_t p=0; p<SCHEDULE_PHASE_QTY; ++p){
+    stats_string_length += sprintf(stats_string + stats_string_length, " %s %.2lf", schedule_phase_name(p), stats->phase_ms[p]);
+  }
+  fontmap_render_string(render, dst, font, color, stats_string, stats_string_length, FONT_ALIGN_H_LEFT | FONT_ALIGN_V_TOP);
+}
+
 void sdl_rect_copy(SDL_Rect* dst, SDL_Rect* src){
   memcpy((void*) dst, (void*) src, sizeof(SDL_Rect));
 }
@@ -1004,558 +313,6 @@ void viewport_active_border_free(Viewport_Active_Border* border){
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-Text_Buffer* editor_buffer_init(){
-  Text_Buffer* tb = (Text_Buffer*) malloc(sizeof(Text_Buffer));
-
-  tb->text = (char*) malloc(EDITOR_BUFFER_LENGTH * sizeof(char));
-  memset(tb->text, 0, EDITOR_BUFFER_LENGTH);
-  tb->length = 0;
-
-  tb->lines = 0;
-  tb->line_task = (Task**) malloc(EDITOR_LINES_MAX * sizeof( *(tb->line_task)));
-  tb->line_length = (int*) malloc(EDITOR_LINES_MAX * sizeof(*tb->line_length));
-  for (size_t i=0; i<EDITOR_LINES_MAX; ++i){
-    tb->line_length[i] = 0;
-  }
-
-  return tb;
-}
-
-void editor_buffer_destroy(Text_Buffer* tb){
-  free(tb->text);
-  free(tb->line_length);
-  free(tb->line_task);
-}
-
-
-// parse text_buffer->text for endlines.
-// store result in text_buffer->lines and text_buffer->line_lengths[]
-void editor_find_line_lengths(Text_Buffer* tb){
-  char* line_start = tb->text;
-  char* line_end = NULL; 
-  char* text_buffer_end = tb->text + tb->length;
-
-  tb->lines = 0;
-  while (tb->lines < EDITOR_LINES_MAX){
-    line_end = memchr(line_start, (int) '\n', text_buffer_end - line_start);
-    if (line_end == NULL){
-      line_end = text_buffer_end;
-    }   
-    else{
-      line_end += 1; // move past the \n
-    }
-
-    tb->line_length[tb->lines] = line_end - line_start;
-
-    tb->lines += 1;
-    line_start = line_end;
-    if (line_end == text_buffer_end){
-      break;
-    }
-  }
-
-  for(int i=tb->lines; i<EDITOR_LINES_MAX; ++i){
-    tb->line_length[i] = 0;
-  }
-}
-
-void editor_cursor_reset(Text_Cursor* text_cursor){
-  text_cursor->pos[0] = 0;
-  text_cursor->x[0] = 0;
-  text_cursor->y[0] = 0;
-  text_cursor->qty = 1;
-  text_cursor->entity_type = TEXTCURSOR_ENTITY_NONE;
-}
-
-
-Text_Cursor* editor_cursor_create(){
-  Text_Cursor* text_cursor = (Text_Cursor*) malloc(sizeof(Text_Cursor));
-  text_cursor->pos = malloc(CURSOR_QTY_MAX * sizeof(*text_cursor->pos));
-  text_cursor->x   = malloc(CURSOR_QTY_MAX * sizeof(*text_cursor->x));
-  text_cursor->y   = malloc(CURSOR_QTY_MAX * sizeof(*text_cursor->y));
-  editor_cursor_reset(text_cursor);
-  text_cursor->task = NULL;
-
-  return text_cursor;
-}
-
-
-void editor_cursor_destroy(Text_Cursor* text_cursor){
-  free(text_cursor->pos);
-  free(text_cursor->x);
-  free(text_cursor->y);
-  free(text_cursor);
-}
-
-
-// given pos, find xy character index for all cursor. shows a problem with 0/1 length lines?
-void editor_cursor_xy_get(Text_Buffer* text_buffer, Text_Cursor* text_cursor){
-  // advance until we find the xy for the first one
-  // then keep advancing but look for the next one
-
-  int line = 0;
-  int sum = text_buffer->line_length[line];
-  for (size_t index=0; index<text_cursor->qty; ++index){
-    while (sum <= text_cursor->pos[index]){ // add to the end of the line (after the cursor)
-      line += 1;
-      sum += text_buffer->line_length[line];
-    }
-    text_cursor->y[index] = line;
-    text_cursor->x[index] = text_buffer->line_length[line] - (sum - text_cursor->pos[index]);
-    printf("pos: %d --> (x,y) = (%d, %d)\n", text_cursor->pos[index], text_cursor->x[index], text_cursor->y[index]);
-
-    // check assumption of cursor ordering
-    if (index > 0){
-      assert(text_cursor->pos[index] > text_cursor->pos[index-1]);
-    }
-  }
-}
-
-
-// set x and y position of cursor, set cursor->pos to the correct value
-// assuming that text_buffer->line_lengths are correct
-void editor_cursor_xy_set(Text_Buffer* text_buffer, Text_Cursor* text_cursor, size_t index, int x, int y){
-  assert(y <= text_buffer->lines);
-  text_cursor->x[index] = x;
-  text_cursor->y[index] = y;
-
-  text_cursor->pos[index] = x;
-  for (int i=0; i<y; ++i){
-    text_cursor->pos[index] += text_buffer->line_length[i];
-  }
-}
-
-
-// lookup what task is pointed to by the editor mode cursor
-void editor_cursor_find_task(Text_Buffer* text_buffer, Text_Cursor* text_cursor){
-  text_cursor->task = text_buffer->line_task[text_cursor->y[0]];
-}
-
-
-size_t editor_cursor_quicksort_partition(int* list, size_t start, size_t end){
-   // pivot value, from the middle of the array
-   int pivot_index = (int) floor((start + end)/2.0 );
-   int pivot = list[pivot_index];
-
-   // left index
-   size_t i = start - 1;
-
-   // right index
-   size_t j = end + 1;
-
-   for(;;){
-      // move the left index to the right (at least once) 
-      // and while element at the left is less than the pivot
-      do {
-         ++i;
-      } while(list[i] < pivot);
-
-      // move the right index to the left at least once 
-      // and while element at the right index is greater than the pivot
-      do {
-         --j;
-      } while (list[j] > pivot);
-
-      // if indices crossed, give up!
-      if (i >= j){
-         return j;
-      }
-
-      // swap
-      int tmp = list[i];
-      list[i] = list[j];
-      list[j] = tmp;
-   }
-
-}
-
-// quicksort thanks to wikipedia ! Hoare partition
-void editor_cursor_quicksort(int* list, size_t start, size_t end){
-   // if ((start >= 0) & (end >= 0) & (start < end)){
-   if (start < end){
-
-      // partition and get pivot index
-      size_t pivot_loc = editor_cursor_quicksort_partition(list, start, end);
-
-      // recursive break into subproblems
-      editor_cursor_quicksort(list, start, pivot_loc);
-      editor_cursor_quicksort(list, pivot_loc+1, end);
-   }
-  
-   return;
-}
-
-
-// sort the cursors in descending order, then recompute xy coordinates
-void editor_cursor_sort(Text_Buffer* text_buffer, Text_Cursor* text_cursor){
-  // sort pos using quicksort
-  editor_cursor_quicksort(text_cursor->pos, 0, text_cursor->qty-1);
-
-  // then process to recompute xy
-  printf("result after sorting..\n");
-  editor_cursor_xy_get(text_buffer, text_cursor);
-}
-
-
-// move one cursor by the given amount
-void editor_cursor_move(Text_Buffer* tb, Text_Cursor* tc, size_t index, int movedir){
-  if (movedir == TEXTCURSOR_MOVE_DIR_RIGHT){
-    if (tc->pos[index] < tb->length-1){
-      tc->pos[index] += 1;
-      tc->x[index] += 1;
-      
-      // wrap to next line
-      if (tc->x[index] == tb->line_length[tc->y[index]]){
-        tc->x[index] = 0;
-        tc->y[index] += 1;
-      }
-    }
-  }
-  else if (movedir == TEXTCURSOR_MOVE_DIR_LEFT){
-    if (tc->pos[index] > 0){
-      tc->pos[index] -= 1;
-      tc->x[index] -= 1;
-
-      // wrap to previous line
-      if(tc->x[index]  < 0){
-        tc->y[index] -= 1;
-        tc->x[index] = tb->line_length[tc->y[index]] - 1;
-      }
-    }
-  }
-  else if (movedir == TEXTCURSOR_MOVE_DIR_UP){
-    if (tc->y[index] > 0){
-      tc->y[index] -= 1;
-
-      int x_delta = tc->x[index];
-      // moving on to a shorter line
-      if (tc->x[index] >= tb->line_length[tc->y[index]]){
-        tc->x[index] = tb->line_length[tc->y[index]]-1;
-        tc->pos[index] -= x_delta + 1;
-      }
-      // moving onto a longer line
-      else{
-        x_delta += tb->line_length[tc->y[index]] - tc->x[index];
-        tc->pos[index] -= x_delta;
-      }
-    }
-  }
-  else if (movedir == TEXTCURSOR_MOVE_DIR_DOWN){
-    if (tc->y[index] < tb->lines-1){
-      int x_delta = tb->line_length[tc->y[index]] - tc->x[index];
-      tc->y[index] += 1;
-
-      // moving onto a shorter line
-      if (tc->x[index] >= tb->line_length[tc->y[index]]){
-        tc->x[index] = tb->line_length[tc->y[index]]-1;
-      }
-        
-      tc->pos[index] += x_delta + tc->x[index];
-    }
-  }
-  else if (movedir == TEXTCURSOR_MOVE_LINE_START){
-    tc->pos[index] -= tc->x[index];
-    tc->x[index] = 0;
-  }
-  else if (movedir == TEXTCURSOR_MOVE_LINE_END){
-    int x_delta = tb->line_length[tc->y[index]] - tc->x[index] - 1;
-    if (x_delta > 0){
-      tc->pos[index] += x_delta;
-      tc->x[index] += x_delta;
-    }
-  }
-
-  printf("move index %lu in direction %d\n", index, movedir);
-}
-
-
-// clear text_buffer, load from a file [filename] and parse it
-void editor_load_text(Task_Memory* task_memory, User_Memory* user_memory, Text_Buffer* text_buffer, const char* filename, Text_Cursor* text_cursor){
-
-  // open the file, create if not exist, use persmissions of current user
-  FILE* fd = fopen(filename, "r"); 
-  if (fd != NULL){
-    char* text_cursor_loading = text_buffer->text;
-    text_buffer->length = 0;
-    do {
-      *text_cursor_loading = fgetc(fd);
-      ++text_cursor_loading;
-      text_buffer->length += 1;
-    } while(*(text_cursor_loading - 1) != EOF);
-    fclose(fd);
-    text_buffer->length -= 1;
-    printf("loaded text of length %d\n", text_buffer->length);
-    printf("text is '%.*s'\n", text_buffer->length, text_buffer->text);
-  }
-  else{
-    printf("[WARNING] FILE '%s' DOES NOT EXIST, CREATING IT\n", filename);
-    fd = fopen(filename, "w");
-    fprintf(fd, " ");
-    fclose(fd);
-
-    // start an empty text buffer
-    text_buffer->text[0] = ' ';
-    text_buffer->length = 1;
-  }
-
-  // do an initial parse of the text information 
-  for (size_t t=0; t<task_memory->allocation_total; ++t){
-    task_memory->tasks[t].mode_edit = TRUE;
-  }
-  editor_parse_text(task_memory, user_memory, text_buffer, text_cursor);
-  editor_find_line_lengths(text_buffer);
-}
-
-///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-
-char* text_append_char(char* text, char new){
-  *text = new;
-  ++text;
-  return text;
-}
-
-
-char* text_append_string(char* text, char* addition){
-  int length = snprintf(NULL, 0, "%s", addition);
-  memcpy(text, addition, length);
-  text += length;
-  return text;
-}
-
-
-// TODO rename to something better - "generate?"
-void editor_text_from_data(Task_Memory* task_memory, Text_Buffer* text_buffer, uint8_t all_tasks){
-  char* text = text_buffer->text;
-  int line_number = 0;
-
-  // Fill the new one
-  for (size_t t=0; t<task_memory->allocation_total; ++t){
-    Task* task = task_memory->tasks + t;
-    if (task->trash == FALSE){
-      if ((task->mode_edit == TRUE) || (task->mode_edit_temp == TRUE) || (all_tasks == TRUE)){
-        // task name
-        memcpy(text, task->task_name, task->task_name_length);
-        text += task->task_name_length;
-        text = text_append_string(text, " {\n");
-
-        text_buffer->line_task[line_number] = task;
-        ++line_number;
-
-        // duration
-        if ((task->schedule_constraints & SCHEDULE_CONSTRAINT_DURATION) > 0){
-          text = text_append_string(text, "  duration: ");
-          int length = snprintf(NULL, 0, "%ld", task->day_duration);
-          int result = snprintf(text, length+1, "%ld", task->day_duration); // +1 due to how snprintf accounts for \0
-          assert(result > 0);
-          text += length;
-          text = text_append_char(text, '\n');
-
-          text_buffer->line_task[line_number] = task;
-          ++line_number;
-        }
-          
-        // prereqs (dependency)
-        if (task->prereq_qty > 0){
-          text = text_append_string(text, "  prereq: ");
-
-          for (size_t i=0; i<task->prereq_qty; ++i){
-            memcpy(text, task->prereqs[i]->task_name, task->prereqs[i]->task_name_length);
-            text += task->prereqs[i]->task_name_length;
-            text = text_append_string(text, ", ");
-          }
-          text -= 2;
-          text = text_append_char(text, '\n');
-
-          text_buffer->line_task[line_number] = task;
-          ++line_number;
-        }
-        
-        // users
-        if (task->user_qty > 0){
-          text = text_append_string(text, "  user: ");
-
-          for (size_t u=0; u<task->user_qty; ++u){
-            memcpy(text, task->users[u]->name, task->users[u]->name_length);
-            text += task->users[u]->name_length;
-            text = text_append_string(text, ", ");
-          }
-          text -= 2;
-          text = text_append_char(text, '\n');
-
-          text_buffer->line_task[line_number] = task;
-          ++line_number;
-        }
-
-        // fixed dates
-        if ((task->schedule_constraints & SCHEDULE_CONSTRAINT_START) > 0){
-          text = text_append_string(text, "  fixed_start: ");
-          text = text_append_date(text, task->day_start);
-          text = text_append_char(text, '\n');
-
-          text_buffer->line_task[line_number] = task;
-          ++line_number;
-        }
-        if ((task->schedule_constraints & SCHEDULE_CONSTRAINT_END) > 0){
-          text = text_append_string(text, "  fixed_end: ");
-          text = text_append_date(text, task->day_end);
-          text = text_append_char(text, '\n');
-
-          text_buffer->line_task[line_number] = task;
-          ++line_number;
-        }
-
-        // color
-        {
-          text = text_append_string(text, "  color: ");
-          int length = snprintf(NULL, 0, "%u", task->status_color);
-          int result = snprintf(text, length+1, "%u", task->status_color);
-          assert(result > 0);
-          text += length;
-          text = text_append_char(text, '\n');
-
-          text_buffer->line_task[line_number] = task;
-          ++line_number;
-        }
-
-        // end this task
-        text = text_append_string(text, "}\n");
-
-        text_buffer->line_task[line_number] = task;
-        ++line_number;
-      }
-    }
-  }
-  text_buffer->length = text - text_buffer->text;
-  text_buffer->lines = line_number;
-
-  if (text_buffer->length == 0){
-    text_buffer->text[0] = ' ';
-    text_buffer->length = 1;
-  }
-}
-
-
-void text_buffer_save(Text_Buffer* text_buffer, char* filename){
-
-  FILE* fd = fopen(filename, "w");
-  if (fd != NULL){
-    fprintf(fd, "%.*s", text_buffer->length, text_buffer->text);
-    fclose(fd);
-    printf("[INFO] save successful.\n");
-  }
-  else{
-    printf("[ERROR] could not open file '%s'.\n", filename);
-  }
-}
-
-
-// find one string (the needle) in another string (they haystack)
-char* strstr_n(char* haystack_start, size_t haystack_n, char* needle, size_t needle_n){
-  printf("looking for %s...\n", needle);
-
-  char* haystack = haystack_start; // current
-  char* haystack_end = haystack_start + haystack_n;
-  int done = 0;
-  while (done == 0){
-    // move the haystack to point at the first occurance of the first letter of the needle
-    haystack = memchr(haystack, (int) needle[0], haystack_end - haystack);
-    if (haystack == NULL){
-      break;
-    }
-
-    // see if the rest of the word follows
-    if (memcmp(haystack, needle, needle_n) == 0){
-      done = 1;
-      break;
-    }
-    else{
-      ++haystack;
-    }
-
-    if (haystack == haystack_end){
-      haystack = NULL;
-      break;
-    }
-  }
-
-  return haystack;
-}
-
-void editor_symbol_rename(Task_Memory* task_memory, User_Memory* user_memory, Text_Buffer* text_buffer, Text_Cursor* text_cursor){
-  printf("[SYMBOL RENAME] FUNCTION ACTIVATED**********************************\n");
-  if (text_cursor->qty > 1){
-    printf("[WARNING] CURRENT ENTITY BASED ONLY ON FIRST CURSOR [0]\n");
-  }
- 
-  // force parsing of the text to update the cursor stuff
-  editor_parse_text(task_memory, user_memory, text_buffer, text_cursor);
-
-  char* keyword = NULL;
-  int keyword_length = 0;
-
-  // if renaming task...
-  if (text_cursor->entity_type == TEXTCURSOR_ENTITY_TASK){
-    printf("renaming task!\n");
-    Task* task = (Task*) text_cursor->entity;
-
-    // get the task name
-    keyword = task->task_name;
-    keyword_length = task->task_name_length;
-    
-    // mark all related tasks in edit mode
-    for (size_t t=0; t<task->dependent_qty; ++t){
-      task->dependents[t]->mode_edit = TRUE;
-    }
-  }
-  else if (text_cursor->entity_type == TEXTCURSOR_ENTITY_USER){
-    printf("renaming user\n");
-    User* user = (User*) text_cursor->entity;
-
-    // set the keyword as name
-    keyword = user->name;
-    keyword_length = user->name_length;
-
-    // mark all related tasks in edit mode
-    for (size_t t=0; t<user->task_qty; ++t){
-      user->tasks[t]->mode_edit = TRUE;
-    }
-  }
-  else if (text_cursor->entity_type == TEXTCURSOR_ENTITY_PREREQ){
-    printf("renaming task by prereq reference!\n");
-    Task* task = (Task*) text_cursor->entity;
-
-    // get the task name
-    keyword = task->task_name;
-    keyword_length = task->task_name_length;
-    
-    // mark all related tasks in edit mode
-    task->mode_edit = TRUE;
-    for (size_t t=0; t<task->dependent_qty; ++t){
-      task->dependents[t]->mode_edit = TRUE;
-    }
-  }
-
-  // regenerate text..
-  editor_text_from_data(task_memory, text_buffer, FALSE); 
-
-  // now deploy the multi-cursors! search text for keyword, add a cursor at the end of each. move the original cursor
-  // TODO how to handle keywords inside of other keywords?
-  text_cursor->qty = 0;
-  char* keyword_location = strstr_n(text_buffer->text, text_buffer->length, keyword, keyword_length);
-  while (keyword_location != NULL){
-    text_cursor->pos[text_cursor->qty] = (keyword_location - text_buffer->text) + keyword_length;
-    keyword_location = strstr_n(keyword_location + keyword_length, text_buffer->length - text_cursor->pos[text_cursor->qty], 
-                                keyword, keyword_length);
-    text_cursor->qty += 1;
-    assert(text_cursor->qty < CURSOR_QTY_MAX);
-  }
-  if (text_cursor->qty == 0){
-    editor_cursor_reset(text_cursor);
-  }
-}
-
-///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-
 
 // TODO this function is way too long and should be divided up for readability and scope control
 int main(int argc, char* argv[]){
@@ -1597,8 +354,13 @@ int main(int argc, char* argv[]){
   tasks_init(task_memory, user_memory);
 
   Schedule_Event_List* schedule_best = schedule_create();
-  Schedule_Event_List* schedule_working = schedule_create();
+  Schedule_Worker* schedule_worker = schedule_worker_create(); // solves in the background, see schedule_worker_request()
   int schedule_solve_status = FAILURE;
+  uint8_t schedule_solver = SCHEDULE_SOLVER_DFS;
+  uint8_t schedule_incremental = FALSE; // only re-solve what an edit touched
+  double schedule_time_budgets_ms[] = {2000, 20000, 0, 20, 200}; // 0 searches until done
+  size_t schedule_time_budget = 0;
+  uint8_t statusbar_expanded = FALSE; // show the solver stats too
 
   // TODO smooth scroll system
   // TODO error flagging / colors system; live syntax parsing
@@ -1606,9 +368,9 @@ int main(int argc, char* argv[]){
   Text_Cursor* text_cursor = editor_cursor_create();
 
   Text_Buffer* text_buffer = editor_buffer_init();
+  text_buffer->journal = editor_journal_create(EDITOR_JOURNAL_BYTES); // only the editor's own text can be undone
   editor_load_text(task_memory, user_memory, text_buffer, argv[1], text_cursor); 
-  schedule_solve_status = schedule_solve(task_memory, schedule_best, schedule_working);
-  uint64_t day_project_start = schedule_best->day_start;
+  uint64_t day_project_start = 0; // set once the first schedule comes back from the worker
 
   // causes some overhead. can control with SDL_StopTextInput()
   SDL_StartTextInput();
@@ -1624,7 +386,9 @@ int main(int argc, char* argv[]){
 
   uint8_t render_text = TRUE;
   uint8_t parse_text = TRUE;
+  Text_Key_Batch key_batch = {0}; // editing keys of this frame, applied at the end of it
   uint8_t display_selection_changed = FALSE; // TODO which is better to init?
+  uint8_t display_tasks_created = FALSE; // the text is regenerated for new tasks, not just another selection
 
   uint32_t timer_last_loop_start_ms = SDL_GetTicks();
   uint32_t timer_target_ms = 10;
@@ -1644,6 +408,9 @@ int main(int argc, char* argv[]){
     SDL_GetWindowSize(win, &window_width, &window_height);
     viewport_statusbar.x = 0;
     viewport_statusbar.h = 20; // TODO 
+    if (statusbar_expanded == TRUE){
+      viewport_statusbar.h += 3 * font_normal.map.max_height;
+    }
     viewport_statusbar.w = window_width;
     viewport_editor.x = 0;
     viewport_editor.y = 0;
@@ -1669,6 +436,14 @@ int main(int argc, char* argv[]){
     // INPUT
     SDL_Event evt;
     while (SDL_PollEvent(&evt) != 0){
+      // anything but an editing key sees the ones before it applied
+      if ((viewport_active != VIEWPORT_EDITOR) || (keybind_editor_text_edit(evt) == FALSE)){
+        if (editor_key_batch_flush(text_buffer, text_cursor, &key_batch) == TRUE){
+          render_text = TRUE;
+          parse_text = TRUE;
+        }
+      }
+
       if (evt.type == SDL_QUIT){
         goto cleanup;
       }
@@ -1708,6 +483,52 @@ int main(int argc, char* argv[]){
         editor_cursor_reset(text_cursor);
      }
 
+     // SOLVER SELECT
+     if (keybind_global_solver_cycle(evt) == TRUE){
+       schedule_solver = (schedule_solver + 1) % SCHEDULE_SOLVER_QTY;
+       printf("[SCHEDULER] switching to solver %s\n", schedule_solver_name(schedule_solver));
+       parse_text = TRUE;
+     }
+     if (keybind_global_incremental_toggle(evt) == TRUE){
+       schedule_incremental = !schedule_incremental;
+       printf("[SCHEDULER] incremental solving %s\n", schedule_incremental == TRUE ? "on" : "off");
+     }
+     if (keybind_global_time_budget_cycle(evt) == TRUE){
+       schedule_time_budget = (schedule_time_budget + 1) % (sizeof(schedule_time_budgets_ms) / sizeof(double));
+       printf("[SCHEDULER] solver time budget %.0lf ms (0 is no limit)\n", schedule_time_budgets_ms[schedule_time_budget]);
+       parse_text = TRUE;
+     }
+     if (keybind_global_stats_toggle(evt) == TRUE){
+       statusbar_expanded = !statusbar_expanded;
+     }
+     if (keybind_global_stats_dump(evt) == TRUE){
+       char stats_filename[256];
+       snprintf(stats_filename, sizeof(stats_filename), "%s.stats.json", argv[1]);
+       FILE* stats_fd = fopen(stats_filename, "w");
+       if (stats_fd == NULL){
+         printf("[WARNING] couldn't open %s to write the solver stats\n", stats_filename);
+       }
+       else{
+         schedule_stats_dump(stats_fd, schedule_best);
+         fclose(stats_fd);
+         printf("[SCHEDULER] solver stats written to %s\n", stats_filename);
+       }
+     }
+
+     // UNDO, REDO the editor text, then parse whatever it says now
+     if (keybind_global_undo(evt) == TRUE){
+       if (editor_journal_undo(text_buffer, text_cursor) == TRUE){
+         render_text = TRUE;
+         parse_text = TRUE;
+       }
+     }
+     if (keybind_global_redo(evt) == TRUE){
+       if (editor_journal_redo(text_buffer, text_cursor) == TRUE){
+         render_text = TRUE;
+         parse_text = TRUE;
+       }
+     }
+
      // use the mouse to adjust relative viewport size
      // start recording the split-adjusting-state
      if (evt.type == SDL_MOUSEBUTTONDOWN){
@@ -1768,47 +589,11 @@ int main(int argc, char* argv[]){
         // special key input
         // TODO cursor management, underline corner style
         if (evt.type == SDL_KEYDOWN){
-          if (evt.key.keysym.sym == SDLK_BACKSPACE && text_buffer->length > 0){
-            for (size_t i=0; i<text_cursor->qty; ++i){
-              // compensate for previous movement
-              for (size_t j=0; j<i; ++j){
-                text_cursor->pos[i] -= 1;
-              }
-
-              // actually remove the character
-              char* text_dst = text_buffer->text + text_cursor->pos[i] - 1;
-              char* text_src = text_dst + 1;
-              char* text_end = text_buffer->text + text_buffer->length;
-              memmove(text_dst, text_src, text_end-text_src); 
-
-              --text_buffer->length;
-              text_buffer->text[text_buffer->length] = '\0';
-              text_buffer->line_length[text_cursor->y[i]] -= 1;
-
-              // now move this cursor left for the backspace action
-              text_cursor->pos[i] -= 1;
-            }
-            render_text = TRUE;
-            parse_text = TRUE;
+          if (evt.key.keysym.sym == SDLK_BACKSPACE){
+            editor_key_batch_backspace(&key_batch);
           }
-          else if( evt.key.keysym.sym == SDLK_DELETE && text_buffer->length > 0){
-            for (size_t i=0; i<text_cursor->qty; ++i){
-              // compensate for previous movement
-              for (size_t j=0; j<i; ++j){
-                text_cursor->pos[i] -= 1;
-              }
-
-              char* text_dst = text_buffer->text + text_cursor->pos[i];
-              char* text_src = text_dst + 1;
-              char* text_end = text_buffer->text + text_buffer->length;
-              memmove(text_dst, text_src, text_end-text_src); 
-
-              --text_buffer->length;
-              text_buffer->text[text_buffer->length] = '\0';
-              text_buffer->line_length[text_cursor->y[i]] -= 1;
-            }
-            render_text = TRUE;
-            parse_text = TRUE;
+          else if( evt.key.keysym.sym == SDLK_DELETE){
+            editor_key_batch_delete(&key_batch);
           }
           // handle copy?
           else if( evt.key.keysym.sym == SDLK_c && SDL_GetModState() & KMOD_CTRL){
@@ -1824,26 +609,7 @@ int main(int argc, char* argv[]){
             printf("paste!\n");
           }
           else if (evt.key.keysym.sym == SDLK_RETURN){
-            for (size_t i=0; i<text_cursor->qty; ++i){
-              // compensate for previous movement
-              for (size_t j=0; j<i; ++j){
-                text_cursor->pos[i] += 1;
-              }
-
-              // move text to make space for inserting characters
-              char* text_src = text_buffer->text + text_cursor->pos[i];
-              char* text_dst = text_src + 1;
-              char* text_end = text_buffer->text + text_buffer->length;
-              memmove(text_dst, text_src, text_end - text_src);
-
-              // actually add the character
-              text_buffer->text[text_cursor->pos[i]] = '\n';
-              ++text_buffer->length;
-              text_cursor->pos[i] += 1;
-            }
-            render_text = TRUE;
-            parse_text = TRUE;
-
+            editor_key_batch_text(text_buffer, text_cursor, &key_batch, "\n", 1);
             printf("[INSERT] RETURN\n"); 
           }
           else if(evt.key.keysym.sym == SDLK_LEFT){
@@ -1884,9 +650,10 @@ int main(int argc, char* argv[]){
             editor_cursor_xy_get(text_buffer, text_cursor);
           }
           else if (keybind_editor_symbol_rename(evt) == TRUE){
-            editor_symbol_rename(task_memory, user_memory, text_buffer, text_cursor);
+            if (editor_symbol_rename(task_memory, user_memory, text_buffer, text_cursor) == TRUE){
+              display_selection_changed = TRUE;
+            }
             parse_text = TRUE;
-            display_selection_changed = TRUE;
           }
           else if (evt.key.keysym.sym == SDLK_F4){ // TODO HACK start things
             printf("line lengths:\n");
@@ -1909,33 +676,8 @@ int main(int argc, char* argv[]){
         } // keypress
         else if ((evt.type == SDL_TEXTINPUT) && !(SDL_GetModState() & KMOD_CTRL)){
           // assume cursors are sorted from soonest to latest in thee text
-          for (size_t i=0; i<text_cursor->qty; ++i){
-            assert(text_buffer->length < EDITOR_BUFFER_LENGTH);
-
-            // update current cursor based on prior text growth. xy needs to be corrected later
-            for (size_t j=0; j<i; ++j){
-              printf("pre move\n");
-              editor_cursor_move(text_buffer, text_cursor, i, TEXTCURSOR_MOVE_DIR_RIGHT);
-            }
-            int pos = text_cursor->pos[i]; // account for previous additions
-            printf("adding character '%c' at %d\n", evt.text.text[0], pos); 
-
-            // move text to make space for inserting characters
-            char* text_src = text_buffer->text + pos; 
-            char* text_dst = text_src + 1;
-            char* text_end = text_buffer->text + text_buffer->length;
-            memmove(text_dst, text_src, text_end - text_src);
-
-            // actually add the character
-            text_buffer->text[pos] = evt.text.text[0];
-            ++text_buffer->length;
-            text_buffer->line_length[text_cursor->y[i]] += 1;
-            printf("final move right\n");
-            editor_cursor_move(text_buffer, text_cursor, i, TEXTCURSOR_MOVE_DIR_RIGHT);
-          }
-
-          render_text = TRUE;
-          parse_text = TRUE;
+          printf("adding character '%c' at %lu cursors\n", evt.text.text[0], text_cursor->qty); 
+          editor_key_batch_text(text_buffer, text_cursor, &key_batch, evt.text.text, 1);
 
         }
         else if(evt.type == SDL_TEXTEDITING){
@@ -1965,7 +707,9 @@ int main(int argc, char* argv[]){
         }
         else if (keybind_display_camera_time_zoom_all(evt) == TRUE){
           display_camera_y = 0;
-          display_pixels_per_day = (viewport_display_body.h ) / (schedule_best->day_duration);
+          if (schedule_best->day_duration > 0){
+            display_pixels_per_day = (viewport_display_body.h ) / (schedule_best->day_duration);
+          }
         }
 
         else if (evt.type == SDL_MOUSEMOTION){
@@ -2130,6 +874,7 @@ int main(int argc, char* argv[]){
 
           parse_text = TRUE;
           display_selection_changed = TRUE;
+          display_tasks_created = TRUE;
         } // end task split 
 
         else if (keybind_display_task_create_successor(evt)){
@@ -2179,6 +924,7 @@ int main(int argc, char* argv[]){
           // mark
           parse_text = TRUE;
           display_selection_changed = TRUE;
+          display_tasks_created = TRUE;
         } // end task create successor
 
         // DISPLAY CURSOR NAVIGATION
@@ -2416,6 +1162,10 @@ int main(int argc, char* argv[]){
       } // viewport display
 
     } // end processing events
+    if (editor_key_batch_flush(text_buffer, text_cursor, &key_batch) == TRUE){
+      render_text = TRUE;
+      parse_text = TRUE;
+    }
     // TODO navigate around the displayed nodes
 
     /////////////////////////////// PROCESSING //////////////////////////////////////////
@@ -2435,24 +1185,36 @@ int main(int argc, char* argv[]){
         }
       }
       editor_text_from_data(task_memory, text_buffer, FALSE); 
-      editor_find_line_lengths(text_buffer);
       editor_cursor_xy_get(text_buffer, text_cursor);
+
+      // undoing the text of new tasks takes them away again. undoing a selection would take tasks out of the text
+      // that are still in edit mode, and the parse would trash them, so the history starts over instead
+      if (display_tasks_created == FALSE){
+        editor_journal_reset(text_buffer->journal);
+      }
+      display_tasks_created = FALSE;
     }
+    editor_journal_group_end(text_buffer->journal);
 
     if (parse_text == TRUE){
       printf("[STATUS] TEXT PARSING REQUESTED--------------------------------------\n");
 
-      // figure out how many lines there are to render
-      editor_find_line_lengths(text_buffer);
+      // the lines are kept up to date by the edits, only the cursors need finding
       editor_cursor_xy_get(text_buffer, text_cursor);
 
       // extract property changes from the text
       editor_parse_text(task_memory, user_memory, text_buffer, text_cursor);
 
-      // PERFORM SCHEDULING!
-      schedule_solve_status = schedule_solve(task_memory, schedule_best, schedule_working);
+      // PERFORM SCHEDULING! on the worker thread, the last good schedule stays up until it's done
+      schedule_worker_request(schedule_worker, task_memory, user_memory, schedule_best, schedule_solver, schedule_incremental, schedule_time_budgets_ms[schedule_time_budget]);
+    }
+
+    uint8_t schedule_collected = schedule_worker_collect(schedule_worker, task_memory, schedule_best, &schedule_solve_status);
+    if (schedule_collected == TRUE){
       day_project_start = schedule_best->day_start;
-      
+    }
+
+    if ((parse_text == TRUE) || (schedule_collected == TRUE)){
       // TODO insert some post scheduling work? to help with laying out things on screen
       // figure out and assign columns to each user
       if (task_memory->allocation_used > 0){
@@ -2587,14 +1349,27 @@ int main(int argc, char* argv[]){
     if (1 == 1){ // TODO if (render_text == TRUE)
       if (text_buffer->length > 0){
         
-        char* line_start = text_buffer->text;
-        char* line_end = NULL; 
-        char* text_buffer_end = text_buffer->text + text_buffer->length;
+        int line_start_pos = 0;
         int line_height_offset = viewport_active_border.border_width * 2;
 
         for(int line_number=0; line_number<text_buffer->lines; ++line_number){
-          line_end = line_start + text_buffer->line_length[line_number];
-          // assert(line_end != line_start);
+          int line_end_pos = line_start_pos + text_buffer->line_length[line_number];
+          if (line_end_pos > text_buffer->length){
+            line_end_pos = text_buffer->length;
+          }
+          char* line_start = editor_buffer_view(text_buffer, line_start_pos, line_end_pos);
+
+          // tasks on a prereq loop can't be scheduled, point them out
+          if ((text_buffer->line_task[line_number] != NULL) && (text_buffer->line_task[line_number]->cycle == TRUE)){
+            SDL_Rect cycle_line_background = {
+              .x = 0,
+              .y = line_height_offset,
+              .w = viewport_editor.w,
+              .h = font_normal.map.max_height
+            };
+            SDL_SetRenderDrawColor(render, 255, 190, 150, 255);
+            SDL_RenderFillRect(render, &cycle_line_background);
+          }
 
           // cursor drawing!
           if (text_cursor->qty == 1){
@@ -2661,8 +1436,8 @@ int main(int argc, char* argv[]){
           }
 
           // advance to the next line
-          line_start = line_end;
-          if (line_start >= text_buffer_end){
+          line_start_pos = line_end_pos;
+          if (line_start_pos >= text_buffer->length){
             break;
           }
 
@@ -2834,7 +1609,10 @@ int main(int argc, char* argv[]){
     
     // display solve time stats
     SDL_RenderSetViewport(render, &viewport_statusbar); // TODO not best practice?
-    draw_time_stats(render, viewport_statusbar, schedule_best, &font_normal);
+    draw_time_stats(render, viewport_statusbar, schedule_best, &font_normal, schedule_worker_stale(schedule_worker));
+    if (statusbar_expanded == TRUE){
+      draw_solve_stats(render, viewport_statusbar, schedule_best, &font_normal);
+    }
     
     // nicer display to indicate the current active viewport
     {
@@ -2874,7 +1652,7 @@ int main(int argc, char* argv[]){
   tasks_free(task_memory, user_memory);
   editor_buffer_destroy(text_buffer);
   schedule_free(schedule_best); 
-  schedule_free(schedule_working);
+  schedule_worker_free(schedule_worker);
   free(task_displays); 
   editor_cursor_destroy(text_cursor);
   return 0;
@@ -0,0 +1,214 @@
+#ifndef SCAN_H
+#define SCAN_H
+
+// one pass over the schedule text that finds every line and every structural character ('{', '}', ':' and ','), so
+// the parser can go line by line without searching each line again. 32 or 16 bytes at a time with AVX2 or SSE2,
+// whichever the compiler was told it can use (e.g. -mavx2 or -march=native), otherwise one byte at a time
+
+// standard system files
+#include <stdlib.h>
+#include <stdint.h>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define SCAN_BLOCK 32
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define SCAN_BLOCK 16
+#else
+#define SCAN_BLOCK 0
+#endif
+
+// what a line holds, one bit per kind of mark
+#define SCAN_MARK_OPEN (1)
+#define SCAN_MARK_CLOSE (1<<1)
+#define SCAN_MARK_COLON (1<<2)
+#define SCAN_MARK_COMMA (1<<3)
+
+typedef struct Scan_Line{
+  int start; // offset into the text
+  int length; // without the '\n'
+  uint8_t marks; // SCAN_MARK_* bits
+  size_t mark_first; // index of its first mark, the next line's is one past its last
+} Scan_Line;
+
+// lines of [start, end) of a text, split the way the parser does it: every '\n' ends one, and whatever comes after the
+// last '\n' is one more line if it isn't empty. marks are the offsets of the structural characters, in order
+typedef struct Scan_Index{
+  char* text; // what the offsets are into
+  Scan_Line* lines; // line_qty of them, and one more that holds where the marks end
+  size_t line_qty;
+  size_t line_max;
+  int* marks;
+  size_t mark_qty;
+  size_t mark_max;
+} Scan_Index;
+
+
+void scan_free(Scan_Index* scan){
+  free(scan->lines);
+  free(scan->marks);
+  scan->lines = NULL;
+  scan->marks = NULL;
+  scan->line_max = 0;
+  scan->mark_max = 0;
+}
+
+
+// room for another block's worth of lines and marks
+void scan_reserve(Scan_Index* scan, size_t bytes){
+  if (scan->line_qty + bytes + 2 > scan->line_max){
+    scan->line_max = 2 * scan->line_max + bytes + 2;
+    scan->lines = (Scan_Line*) realloc(scan->lines, scan->line_max * sizeof(Scan_Line));
+  }
+  if (scan->mark_qty + bytes > scan->mark_max){
+    scan->mark_max = 2 * scan->mark_max + bytes;
+    scan->marks = (int*) realloc(scan->marks, scan->mark_max * sizeof(int));
+  }
+}
+
+
+uint8_t scan_mark_kind(char c){
+  switch (c){
+    case '{': return SCAN_MARK_OPEN;
+    case '}': return SCAN_MARK_CLOSE;
+    case ':': return SCAN_MARK_COLON;
+    case ',': return SCAN_MARK_COMMA;
+    default: return 0;
+  }
+}
+
+
+// a '\n' at pos ends the open line and starts the next one
+void scan_newline(Scan_Index* scan, int pos){
+  Scan_Line* line = scan->lines + scan->line_qty;
+  line->length = pos - line->start;
+  scan->line_qty += 1;
+  line += 1;
+  line->start = pos + 1;
+  line->length = 0;
+  line->marks = 0;
+  line->mark_first = scan->mark_qty;
+}
+
+
+void scan_mark(Scan_Index* scan, int pos, uint8_t kind){
+  scan->marks[scan->mark_qty] = pos;
+  scan->mark_qty += 1;
+  scan->lines[scan->line_qty].marks |= kind;
+}
+
+
+// one byte at a time, for the bytes after the last whole block, and everything without SIMD
+void scan_bytes(Scan_Index* scan, char* text, int start, int end){
+  scan_reserve(scan, end - start);
+  for (int pos=start; pos<end; ++pos){
+    if (text[pos] == '\n'){
+      scan_newline(scan, pos);
+    }
+    else{
+      uint8_t kind = scan_mark_kind(text[pos]);
+      if (kind != 0){
+        scan_mark(scan, pos, kind);
+      }
+    }
+  }
+}
+
+
+#if SCAN_BLOCK > 0
+// bit i set where block[i] is a '\n', and in *structural where it is one of "{}:,"
+uint32_t scan_block(char* block, uint32_t* structural){
+#if defined(__AVX2__)
+  // classify each byte by looking up its low and high nibbles: a byte is of a class when both lookups have its bit.
+  // '\n' 0x0A, ',' 0x2C, ':' 0x3A, '{' 0x7B and '}' 0x7D
+  const __m256i table_low = _mm256_setr_epi8(0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1|4, 8, 2, 16, 0, 0,
+                                             0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1|4, 8, 2, 16, 0, 0);
+  const __m256i table_high = _mm256_setr_epi8(1, 0, 2, 4, 0, 0, 0, 8|16, 0, 0, 0, 0, 0, 0, 0, 0,
+                                              1, 0, 2, 4, 0, 0, 0, 8|16, 0, 0, 0, 0, 0, 0, 0, 0);
+  const __m256i nibble = _mm256_set1_epi8(0x0F);
+  __m256i bytes = _mm256_loadu_si256((const __m256i*) block);
+  __m256i low = _mm256_shuffle_epi8(table_low, _mm256_and_si256(bytes, nibble));
+  __m256i high = _mm256_shuffle_epi8(table_high, _mm256_and_si256(_mm256_srli_epi16(bytes, 4), nibble));
+  __m256i classes = _mm256_and_si256(low, high);
+  __m256i zero = _mm256_setzero_si256();
+  uint32_t newlines = (uint32_t) _mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_and_si256(classes, _mm256_set1_epi8(1)), zero));
+  uint32_t others = (uint32_t) _mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_and_si256(classes, _mm256_set1_epi8(2|4|8|16)), zero));
+  *structural = ~others;
+  return ~newlines;
+#else
+  __m128i bytes = _mm_loadu_si128((const __m128i*) block);
+  __m128i newlines = _mm_cmpeq_epi8(bytes, _mm_set1_epi8('\n'));
+  __m128i others = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(bytes, _mm_set1_epi8('{')), _mm_cmpeq_epi8(bytes, _mm_set1_epi8('}'))),
+                                _mm_or_si128(_mm_cmpeq_epi8(bytes, _mm_set1_epi8(':')), _mm_cmpeq_epi8(bytes, _mm_set1_epi8(','))));
+  *structural = (uint32_t) _mm_movemask_epi8(others);
+  return (uint32_t) _mm_movemask_epi8(newlines);
+#endif
+}
+#endif
+
+
+// index the lines and marks of text in [start, end), replacing what the index held
+void scan_text(Scan_Index* scan, char* text, int start, int end){
+  scan->text = text;
+  scan->line_qty = 0;
+  scan->mark_qty = 0;
+  scan_reserve(scan, 0);
+  scan->lines[0].start = start;
+  scan->lines[0].length = 0;
+  scan->lines[0].marks = 0;
+  scan->lines[0].mark_first = 0;
+
+  int pos = start;
+#if SCAN_BLOCK > 0
+  for (; pos + SCAN_BLOCK <= end; pos += SCAN_BLOCK){
+    uint32_t structural;
+    uint32_t newlines = scan_block(text + pos, &structural);
+    uint32_t found = newlines | structural;
+    if (found == 0){
+      continue;
+    }
+    scan_reserve(scan, SCAN_BLOCK);
+    while (found != 0){
+      int i = __builtin_ctz(found);
+      found &= found - 1;
+      if ((newlines >> i) & 1){
+        scan_newline(scan, pos + i);
+      }
+      else{
+        scan_mark(scan, pos + i, scan_mark_kind(text[pos + i]));
+      }
+    }
+  }
+#endif
+  scan_bytes(scan, text, pos, end);
+
+  // the open line counts if it isn't empty. either way the one after the last holds where the marks end
+  Scan_Line* line = scan->lines + scan->line_qty;
+  if (line->start < end){
+    line->length = end - line->start;
+    scan->line_qty += 1;
+    line += 1;
+    line->start = end;
+    line->length = 0;
+    line->marks = 0;
+  }
+  line->mark_first = scan->mark_qty;
+}
+
+
+// offset of the first c on the line at or after pos, or the end of the line. *mark starts at the line's first mark
+// and moves along with it, so a line can be split on one character after another
+int scan_line_find(Scan_Index* scan, size_t line, size_t* mark, int pos, char c){
+  size_t mark_end = scan->lines[line + 1].mark_first;
+  while (*mark < mark_end){
+    int found = scan->marks[*mark];
+    if ((found >= pos) && (scan->text[found] == c)){
+      return found;
+    }
+    *mark += 1;
+  }
+  return scan->lines[line].start + scan->lines[line].length;
+}
+
+#endif
@@ -1,13 +1,18 @@
+#ifndef SCHEDULE_H
+#define SCHEDULE_H
+
 #include <SDL2/SDL.h>
 #include <stdint.h>
+#include <time.h>
 #include "lib/hashtable.h"
+#include "scan.h"
 
 #define FALSE 0
 #define TRUE 1
 #define SUCCESS 2
 #define FAILURE 3
 
-// maximum possible number of tasks and users hardcoded since I don't have a hashtable-resizing function
+// size of the task and user hashtables. they don't resize, only tasks_reserve() can make them bigger, while empty
 #define HT_TASKS_MAX 8192
 #define HT_USERS_MAX 1024
 
@@ -31,6 +36,18 @@
 typedef struct Task Task;
 typedef struct Task_Display Task_Display;
 
+// a scheduled task in one of its users' busy trees, see USER BUSY INDEX. each task holds one per user, so a user's
+// tree never has more nodes than they have tasks. the subtree fields cover the node and everything under it
+typedef struct Schedule_Busy_Node{
+  Task* task;
+  struct Schedule_Busy_Node* child[2]; // earlier and later starts
+  uint32_t priority; // heap ordered, higher is nearer the root
+  uint64_t start_min; // first start in the subtree
+  uint64_t start_max; // last start in the subtree
+  uint64_t end_max; // last day any task of the subtree is busy
+  uint64_t gap_max; // longest free stretch between tasks of the subtree, not counting the one before its first
+} Schedule_Busy_Node;
+
 typedef struct User{
   char* name;
   size_t name_length;
@@ -41,6 +58,18 @@ typedef struct User{
   // network properties
   Task* tasks[USER_TASKS_MAX];
   size_t task_qty;
+  size_t editor_symbol; // one place the editor text names it, see Text_Symbol
+
+  // solver working variables
+  uint64_t schedule_workload; // days of work this user must do, no matter the order
+  uint8_t schedule_repair; // TRUE once an incremental repair has put this user's frozen tasks back in the busy index
+
+  struct User* schedule_island_copy; // this user's copy in its island, while splitting the project up
+
+  // scheduled tasks in a treap ordered by day_start, see USER BUSY INDEX
+  Schedule_Busy_Node* schedule_busy_root;
+  size_t schedule_busy_qty;
+  uint32_t schedule_busy_seed; // for node priorities, reset with the tree so a solve always builds the same one
 
   // display properties
   uint32_t column_center_px;
@@ -76,6 +105,7 @@ struct Task{
   uint64_t day_start;
   uint64_t day_duration;
   uint64_t day_end;
+  uint64_t day_no_sooner; // earliest allowed start, with SCHEDULE_CONSTRAINT_NOSOONER
 
   uint8_t status_color;
   uint16_t subsystem_id;
@@ -86,6 +116,23 @@ struct Task{
 
   Task_Display* dependents_display[TASK_USERS_MAX * TASK_DEPENDENCIES_MAX];
   size_t dependents_display_qty;
+
+  uint8_t cycle; // on a prereq loop, see task_cycles_find()
+  size_t editor_symbol; // one place the editor text names it, see Text_Symbol
+
+  // SOLVER WORKING VARIABLES BELOW THIS LINE
+  size_t schedule_prereq_remaining; // prereqs not yet scheduled
+  size_t schedule_dependent_remaining; // dependents not yet scheduled
+  uint64_t schedule_path_length; // longest chain of durations from the start of this task to the end of the project
+  uint64_t schedule_latest_finish; // latest allowed end day due to fixed dependents, UINT64_MAX if unconstrained
+  int64_t schedule_bound_head; // days that prereq chains must occupy before this task starts
+  int64_t schedule_bound_tail; // days that dependent chains must occupy after this task ends
+  uint64_t schedule_earliest_start; // start window, see schedule_windows_prepare()
+  uint64_t schedule_latest_start;
+  uint64_t schedule_signature; // scheduler inputs at the last successful solve, see schedule_task_signature()
+  uint64_t schedule_day_previous; // start day in the last solved schedule, UINT64_MAX if it wasn't in it
+  uint8_t schedule_dirty; // needs to be placed again by an incremental solve
+  Schedule_Busy_Node schedule_busy_nodes[TASK_USERS_MAX]; // this task in the busy tree of users[u]
 };
 
 typedef struct Task_Memory{
@@ -96,6 +143,10 @@ typedef struct Task_Memory{
   size_t last_created;
   uint8_t* editor_visited;
   uint8_t* temp_status;
+
+  // solver bitsets, one bit per task slot. see schedule_ready_words()
+  uint64_t* schedule_ready; // not scheduled, and all prereqs or all dependents are scheduled
+  uint64_t* schedule_pending; // not scheduled
 } Task_Memory;
 
 
@@ -168,12 +219,87 @@ void status_color_init(){
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+// a task's lines in the editor text, from its '{' line up to the next one. the parser keeps them so an edit only needs
+// the blocks it touched parsed again
+typedef struct Text_Block{
+  size_t task; // index into task_memory->tasks, SIZE_MAX for text before the first task or a '{' line with no name
+  int start;
+  int line;
+} Text_Block;
+
+// a task or user named in the editor text: a task's name on its '{' line, or a name in a prereq: or user: list. kept
+// in text order by the parser, so the places a name is used are known without searching the text for it
+typedef struct Text_Symbol{
+  uint8_t type; // TEXTCURSOR_ENTITY_TASK, _PREREQ or _USER
+  void* entity; // the Task* or User* it names
+  int start;
+  int length;
+  size_t prev; // the other places its entity is named, in no order. SIZE_MAX at the ends, see editor_symbol_first()
+  size_t next;
+} Text_Symbol;
+
+// the edits made to a text, newest last, each kept as the bytes it removed and inserted so it can be taken back or made
+// again. records are appended into a ring of size bytes and the oldest groups are dropped to make room. a group is
+// what was edited in one frame, undo and redo go a whole group at a time. see editor_journal_record()
+typedef struct Text_Journal{
+  uint8_t* bytes;
+  size_t size;
+  size_t tail; // oldest record. tail, head and redo_end only grow, they're taken modulo size into bytes
+  size_t head; // one past the newest record
+  size_t redo_end; // [head, redo_end) are records that were undone and can be redone
+  uint8_t group_open; // the next record is part of the same group as the last one
+  uint8_t group_dropped; // the open group didn't fit, the rest of it isn't kept either
+  uint8_t replaying; // undo and redo are applying records, they aren't new ones
+} Text_Journal;
+
+// one record read back out of a journal, with where its removed and inserted bytes are in it
+typedef struct Text_Journal_Record{
+  size_t start;
+  size_t end;
+  uint8_t flags;
+  int pos;
+  int removed;
+  int inserted;
+  size_t removed_at;
+  size_t inserted_at;
+} Text_Journal_Record;
+
+// a gap buffer: the text is kept in text_max bytes with a gap of unused ones at gap_start, where the last edit was, so
+// typing there doesn't move the rest. read it through editor_buffer_view(), change it with editor_buffer_insert() and
+// editor_buffer_delete()
 typedef struct Text_Buffer{
   char* text;
-  int length;
+  int length; // bytes of text, not counting the gap
+  int gap_start;
+  int gap_length;
+  int text_max;
   int* line_length; // [pointer to lineA start] + [line_length A] = [pointer to lineB start]
   int lines;
   Task** line_task; // pointer to what task this line corresponds to
+  int* line_tree; // Fenwick tree over line_length, see editor_lines_index()
+  int lines_max; // room in line_length and line_task
+  Scan_Index scan; // lines and marks of whatever the parser last looked at, see scan_text()
+
+  // blocks found by the last parse, in text order, and the size of the text it saw
+  Text_Block* blocks;
+  size_t block_qty;
+  size_t block_max;
+  int parsed_length;
+  int parsed_lines;
+  uint8_t parsed_repeats; // some task is named by more than one block, so they all have to be parsed together
+  Text_Symbol* symbols; // every name in the text the last parse saw, see editor_symbol_push()
+  size_t symbol_qty;
+  size_t symbol_max;
+
+  // bytes changed since the last parse, see editor_buffer_edited(). [0, edit_start) is unchanged since the last parse,
+  // and so is [edit_end, length), which was [edit_end_parsed, parsed_length) back then
+  uint8_t edit_all; // the text changed without saying where, parse all of it
+  uint8_t edit_pending;
+  int edit_start;
+  int edit_end;
+  int edit_end_parsed;
+
+  Text_Journal* journal; // NULL when its edits can't be undone
 } Text_Buffer;
 
 typedef struct Text_Cursor{
@@ -186,6 +312,25 @@ typedef struct Text_Cursor{
   Task* task;
 } Text_Cursor;
 
+// one change to the text: removed bytes at pos replaced by inserted ones, found at an offset into the bytes passed
+// along with it. editor_buffer_apply() takes a sorted list of these
+typedef struct Text_Edit{
+  int pos;
+  int removed;
+  int inserted;
+  int bytes;
+} Text_Edit;
+
+// the editing keys pressed during one frame, the same at every cursor: backspaces before it, deletes after it, and
+// the text typed in between. editor_key_batch_flush() applies them all at once
+#define TEXT_KEY_BATCH_MAX 256
+typedef struct Text_Key_Batch{
+  int backspaces;
+  int deletes;
+  int text_length;
+  char text[TEXT_KEY_BATCH_MAX];
+} Text_Key_Batch;
+
 enum TEXTCURSOR_MOVE_DIR {
   TEXTCURSOR_MOVE_DIR_RIGHT,
   TEXTCURSOR_MOVE_DIR_LEFT,
@@ -215,8 +360,48 @@ enum TEXTCURSOR_ENTITY_TYPE {
 typedef struct Schedule_Event {
   uint64_t date;
   Task* task;
+
+  // running lower bound on the project start and end, given every event up to and including this one
+  int64_t bound_start;
+  int64_t bound_end;
+
+  // the task's dates before it was scheduled, schedule_task_pop() puts them back
+  uint64_t day_start_previous;
+  uint64_t day_end_previous;
 } Schedule_Event;
 
+// available solution methods. DFS is exhaustive, LIST is a single pass serial schedule generation scheme
+enum SCHEDULE_SOLVER {
+  SCHEDULE_SOLVER_DFS,
+  SCHEDULE_SOLVER_DFS_BOUNDED, // DFS, abandon branches that can't beat the best schedule so far
+  SCHEDULE_SOLVER_LIST_PATH, // list scheduler, longest path to the end of the project goes first
+  SCHEDULE_SOLVER_LIST_FINISH, // list scheduler, earliest latest-finish goes first
+  SCHEDULE_SOLVER_PORTFOLIO, // bounded DFS raced on every core, each with its own task order, sharing the best duration
+  SCHEDULE_SOLVER_DFS_PARALLEL, // one bounded DFS split across every core, idle threads steal subtrees
+  SCHEDULE_SOLVER_QTY
+};
+
+// the steps of a solve, timed separately in Schedule_Stats
+enum SCHEDULE_PHASE {
+  SCHEDULE_PHASE_PREPARE, // lower bounds, fixed tasks
+  SCHEDULE_PHASE_WINDOWS, // start windows, see schedule_windows_prepare()
+  SCHEDULE_PHASE_SEED, // the quick list schedule ahead of a search with a time budget
+  SCHEDULE_PHASE_SEARCH, // the DFS, or the list scheduler
+  SCHEDULE_PHASE_FINISH, // moving the tasks to the best schedule
+  SCHEDULE_PHASE_QTY
+};
+
+// where a solve spent its effort, for tuning the search. nodes and prunes are search_nodes and search_prunes
+// a solve spread over threads adds up the threads, so its phase times are cpu time rather than wall time
+typedef struct Schedule_Stats {
+  uint64_t backtracks; // tasks taken back off the schedule
+  uint64_t failed_pushes; // tasks that found no place to go
+  uint64_t conflict_checks; // user availability lookups
+  uint64_t shift_iterations; // times a task was moved past a busy user
+  size_t depth_max; // most events on the schedule at once
+  double phase_ms[SCHEDULE_PHASE_QTY];
+} Schedule_Stats;
+
 typedef struct Schedule_Event_List {
   size_t qty;
   size_t qty_max;
@@ -225,7 +410,32 @@ typedef struct Schedule_Event_List {
   uint64_t day_duration;
   double solve_time_ms;
   uint8_t solved;
+  uint8_t solver;
   Schedule_Event* events;
+
+  // search effort
+  uint64_t search_nodes;
+  uint64_t search_prunes;
+  int64_t bound_workload; // no schedule can be shorter than the busiest user's workload
+  size_t repaired_qty; // tasks placed again by an incremental solve, 0 after a full solve
+  Schedule_Stats stats;
+
+  // anytime search
+  double time_budget_ms; // stop searching after this long and keep the best so far. 0 for no limit
+  uint64_t timer_start; // performance counter at the start of the solve
+  uint64_t improvements; // better schedules found so far in this solve
+  uint8_t timed_out; // the budget ran out before the search finished
+  uint8_t optimal; // the search ran to the end, no better schedule exists in the search space
+  SDL_atomic_t* cancel; // another thread sets this non-zero to stop the search early. NULL if never
+  struct Schedule_Event_List* progress; // gets a copy of every better schedule as it is found, under progress_lock. NULL if not wanted
+  SDL_mutex* progress_lock;
+  SDL_atomic_t* incumbent; // best duration found by any search in a portfolio, pruned against and lowered on improvement. NULL if searching alone
+  struct Schedule_Search_Worker* search; // the parallel DFS thread this search runs on, for handing out subtrees. NULL if searching alone
+
+  // the best schedule as the start day of every task, by task index. the search keeps only this up to date,
+  // the events are put together once it's over, see schedule_best_events()
+  uint64_t* day_starts;
+  size_t day_starts_qty;
 } Schedule_Event_List;
 
 
@@ -233,11 +443,126 @@ Schedule_Event_List* schedule_create(){
   Schedule_Event_List* schedule = (Schedule_Event_List*) malloc(sizeof(Schedule_Event_List));
   schedule->qty = 0;
   schedule->qty_max = 64;
+  schedule->day_start = 0;
+  schedule->day_end = 0;
+  schedule->day_duration = 0;
+  schedule->solve_time_ms = 0;
   schedule->events = (Schedule_Event*) malloc(schedule->qty_max * sizeof(Schedule_Event));
   schedule->solved = FALSE;
+  schedule->solver = SCHEDULE_SOLVER_DFS;
+  schedule->search_nodes = 0;
+  schedule->search_prunes = 0;
+  schedule->bound_workload = 0;
+  schedule->repaired_qty = 0;
+  memset(&schedule->stats, 0, sizeof(Schedule_Stats));
+  schedule->time_budget_ms = 0;
+  schedule->timer_start = 0;
+  schedule->improvements = 0;
+  schedule->timed_out = FALSE;
+  schedule->optimal = FALSE;
+  schedule->cancel = NULL;
+  schedule->progress = NULL;
+  schedule->progress_lock = NULL;
+  schedule->incumbent = NULL;
+  schedule->search = NULL;
+  schedule->day_starts = NULL;
+  schedule->day_starts_qty = 0;
   return schedule;
 }
 
+
+const char* schedule_solver_name(uint8_t solver){
+  if (solver == SCHEDULE_SOLVER_DFS){
+    return "DFS";
+  }
+  else if (solver == SCHEDULE_SOLVER_DFS_BOUNDED){
+    return "DFS (bounded)";
+  }
+  else if (solver == SCHEDULE_SOLVER_LIST_PATH){
+    return "List (longest path)";
+  }
+  else if (solver == SCHEDULE_SOLVER_LIST_FINISH){
+    return "List (latest finish)";
+  }
+  else if (solver == SCHEDULE_SOLVER_PORTFOLIO){
+    return "Portfolio";
+  }
+  else if (solver == SCHEDULE_SOLVER_DFS_PARALLEL){
+    return "DFS (parallel)";
+  }
+  return "unknown";
+}
+
+const char* schedule_phase_name(uint8_t phase){
+  if (phase == SCHEDULE_PHASE_PREPARE){
+    return "prepare";
+  }
+  else if (phase == SCHEDULE_PHASE_WINDOWS){
+    return "windows";
+  }
+  else if (phase == SCHEDULE_PHASE_SEED){
+    return "seed";
+  }
+  else if (phase == SCHEDULE_PHASE_SEARCH){
+    return "search";
+  }
+  else if (phase == SCHEDULE_PHASE_FINISH){
+    return "finish";
+  }
+  return "unknown";
+}
+
+
+// charge the time since *lap to a phase, and start the next lap
+void schedule_stats_lap(Schedule_Stats* stats, uint8_t phase, uint64_t* lap){
+  uint64_t cpu_timer_now = SDL_GetPerformanceCounter();
+  stats->phase_ms[phase] += ((double) cpu_timer_now - *lap) * 1000 / ((double) SDL_GetPerformanceFrequency());
+  *lap = cpu_timer_now;
+}
+
+
+// fold the stats of another search into dst
+void schedule_stats_add(Schedule_Stats* dst, Schedule_Stats* src){
+  dst->backtracks += src->backtracks;
+  dst->failed_pushes += src->failed_pushes;
+  dst->conflict_checks += src->conflict_checks;
+  dst->shift_iterations += src->shift_iterations;
+  if (src->depth_max > dst->depth_max){
+    dst->depth_max = src->depth_max;
+  }
+  for (size_t p=0; p<SCHEDULE_PHASE_QTY; ++p){
+    dst->phase_ms[p] += src->phase_ms[p];
+  }
+}
+
+
+// write the effort of the last solve as a JSON object, for looking at offline
+void schedule_stats_dump(FILE* file, Schedule_Event_List* schedule){
+  Schedule_Stats* stats = &schedule->stats;
+  fprintf(file, "{\n");
+  fprintf(file, "  \"solver\": \"%s\",\n", schedule_solver_name(schedule->solver));
+  fprintf(file, "  \"solved\": %s,\n", (schedule->solved == TRUE) ? "true" : "false");
+  fprintf(file, "  \"optimal\": %s,\n", (schedule->optimal == TRUE) ? "true" : "false");
+  fprintf(file, "  \"timed_out\": %s,\n", (schedule->timed_out == TRUE) ? "true" : "false");
+  fprintf(file, "  \"duration\": %lu,\n", schedule->day_duration);
+  fprintf(file, "  \"solve_time_ms\": %.3lf,\n", schedule->solve_time_ms);
+  fprintf(file, "  \"improvements\": %lu,\n", schedule->improvements);
+  fprintf(file, "  \"repaired\": %lu,\n", schedule->repaired_qty);
+  fprintf(file, "  \"nodes\": %lu,\n", schedule->search_nodes);
+  fprintf(file, "  \"prunes\": %lu,\n", schedule->search_prunes);
+  fprintf(file, "  \"backtracks\": %lu,\n", stats->backtracks);
+  fprintf(file, "  \"failed_pushes\": %lu,\n", stats->failed_pushes);
+  fprintf(file, "  \"conflict_checks\": %lu,\n", stats->conflict_checks);
+  fprintf(file, "  \"shift_iterations\": %lu,\n", stats->shift_iterations);
+  fprintf(file, "  \"depth_max\": %lu,\n", stats->depth_max);
+  fprintf(file, "  \"phase_ms\": {");
+  for (size_t p=0; p<SCHEDULE_PHASE_QTY; ++p){
+    fprintf(file, "%s\"%s\": %.3lf", (p > 0) ? ", " : "", schedule_phase_name(p), stats->phase_ms[p]);
+  }
+  fprintf(file, "}\n");
+  fprintf(file, "}\n");
+}
+
 void schedule_memory_management(Schedule_Event_List* schedule){
   if (schedule->qty >= schedule->qty_max){
     printf("[CAUTION] SCHEDULE MEMORY MANAGEMENT ACTIVATED, INCREASING MEMORY ALLOCATIONS\n");
@@ -248,16 +573,147 @@ void schedule_memory_management(Schedule_Event_List* schedule){
 
 void schedule_free(Schedule_Event_List* schedule){
   free(schedule->events);
+  free(schedule->day_starts);
   free(schedule);
 }
 
 
 // copy the schedule from src to dst. namely for use in saving the current best schedule
 void schedule_copy(Schedule_Event_List* dst, Schedule_Event_List* src){
+  // the event and start day storage, and the links to other threads belong to dst
   Schedule_Event* events_tmp = dst->events;
+  uint64_t* day_starts_tmp = dst->day_starts;
+  size_t day_starts_qty_tmp = dst->day_starts_qty;
+  size_t qty_max_tmp = dst->qty_max;
+  SDL_atomic_t* cancel_tmp = dst->cancel;
+  Schedule_Event_List* progress_tmp = dst->progress;
+  SDL_mutex* progress_lock_tmp = dst->progress_lock;
+  SDL_atomic_t* incumbent_tmp = dst->incumbent;
+  struct Schedule_Search_Worker* search_tmp = dst->search;
   memcpy(dst, src, sizeof (Schedule_Event_List));
   dst->events = events_tmp;
-  memcpy(dst->events, src->events, sizeof( Schedule_Event) * dst->qty_max);
+  dst->day_starts = day_starts_tmp;
+  dst->day_starts_qty = day_starts_qty_tmp;
+  dst->qty_max = qty_max_tmp;
+  dst->cancel = cancel_tmp;
+  dst->progress = progress_tmp;
+  dst->progress_lock = progress_lock_tmp;
+  dst->incumbent = incumbent_tmp;
+  dst->search = search_tmp;
+
+  // src may have grown past what dst has allocated
+  if (dst->qty_max < src->qty_max){
+    dst->qty_max = src->qty_max;
+    dst->events = (Schedule_Event*) realloc(dst->events, dst->qty_max * sizeof(Schedule_Event));
+  }
+  memcpy(dst->events, src->events, sizeof( Schedule_Event) * src->qty);
+}
+
+
+// append a task at its current start date to the end of the event list
+void schedule_event_add(Schedule_Event_List* schedule, Task* task){
+  schedule->qty += 1;
+  schedule_memory_management(schedule);
+  Schedule_Event* event = schedule->events + schedule->qty - 1;
+  event->task = task;
+  event->date = task->day_start;
+  event->day_start_previous = task->day_start;
+  event->day_end_previous = task->day_end;
+
+  // the project can't start later than this task's prereq chains allow, or end sooner than its dependent chains
+  event->bound_start = (int64_t) task->day_start - task->schedule_bound_head;
+  event->bound_end = (int64_t) task->day_end + task->schedule_bound_tail;
+  if (schedule->qty > 1){
+    Schedule_Event* previous = event - 1;
+    if (previous->bound_start < event->bound_start){
+      event->bound_start = previous->bound_start;
+    }
+    if (previous->bound_end > event->bound_end){
+      event->bound_end = previous->bound_end;
+    }
+  }
+}
+
+
+// lowest possible duration of any complete schedule grown from the current event list
+int64_t schedule_lower_bound(Schedule_Event_List* schedule){
+  int64_t bound = schedule->bound_workload;
+  if (schedule->qty > 0){
+    Schedule_Event* event = schedule->events + schedule->qty - 1;
+    if (event->bound_end - event->bound_start > bound){
+      bound = event->bound_end - event->bound_start;
+    }
+  }
+  return bound;
+}
+
+
+double schedule_elapsed_ms(Schedule_Event_List* schedule){
+  uint64_t cpu_timer_now = SDL_GetPerformanceCounter();
+  return ((double) cpu_timer_now - schedule->timer_start) * 1000 / ((double) SDL_GetPerformanceFrequency());
+}
+
+
+// TRUE if the search should stop now: cancelled from another thread, or out of time
+int schedule_search_stop(Schedule_Event_List* schedule_working){
+  if ((schedule_working->cancel != NULL) && (SDL_AtomicGet(schedule_working->cancel) != 0)){
+    return TRUE;
+  }
+  // reading the clock every node is wasteful, every 256 is plenty
+  if ((schedule_working->time_budget_ms > 0) && ((schedule_working->search_nodes & 0xFF) == 0)){
+    if (schedule_elapsed_ms(schedule_working) > schedule_working->time_budget_ms){
+      schedule_working->timed_out = TRUE;
+    }
+  }
+  return schedule_working->timed_out;
+}
+
+
+// the working schedule is the best one yet. keep its start days, and hand a copy to whoever is watching
+void schedule_improved(Task_Memory* task_memory, Schedule_Event_List* schedule_best, Schedule_Event_List* schedule_working){
+  schedule_working->improvements += 1;
+  schedule_working->solve_time_ms = schedule_elapsed_ms(schedule_working);
+  schedule_best->solved = TRUE;
+  schedule_best->day_start = schedule_working->day_start;
+  schedule_best->day_end = schedule_working->day_end;
+  schedule_best->day_duration = schedule_working->day_duration;
+  schedule_best->solve_time_ms = schedule_working->solve_time_ms;
+  if (schedule_best->day_starts_qty < task_memory->allocation_total){
+    schedule_best->day_starts_qty = task_memory->allocation_total;
+    schedule_best->day_starts = (uint64_t*) realloc(schedule_best->day_starts, schedule_best->day_starts_qty * sizeof(uint64_t));
+  }
+  for (size_t t=0; t<task_memory->allocation_total; ++t){
+    schedule_best->day_starts[t] = task_memory->tasks[t].day_start;
+  }
+
+  if (schedule_working->progress != NULL){
+    SDL_LockMutex(schedule_working->progress_lock);
+    schedule_copy(schedule_working->progress, schedule_working);
+    SDL_UnlockMutex(schedule_working->progress_lock);
+  }
+
+  // let the rest of the portfolio prune against this one. durations too long to share just aren't
+  if ((schedule_working->incumbent != NULL) && (schedule_working->day_duration < (uint64_t) SDL_MAX_SINT32)){
+    int duration = (int) schedule_working->day_duration;
+    int incumbent = SDL_AtomicGet(schedule_working->incumbent);
+    while ((duration < incumbent) && (SDL_AtomicCAS(schedule_working->incumbent, incumbent, duration) == SDL_FALSE)){
+      incumbent = SDL_AtomicGet(schedule_working->incumbent);
+    }
+  }
+}
+
+
+// rebuild the best schedule's events from its start days, and move the tasks there
+void schedule_best_events(Task_Memory* task_memory, Schedule_Event_List* schedule_best){
+  schedule_best->qty = 0;
+  for (size_t t=0; t<task_memory->allocation_total; ++t){
+    Task* task = task_memory->tasks + t;
+    if (task->trash == FALSE){
+      task->day_start = schedule_best->day_starts[t];
+      task->day_end = task->day_start + task->day_duration - 1;
+      schedule_event_add(schedule_best, task);
+    }
+  }
 }
 
 
@@ -282,48 +738,478 @@ void schedule_calculate_duration(Schedule_Event_List* schedule, Task_Memory* tas
 }
 
 
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// USER BUSY INDEX
+// each user keeps their scheduled tasks in a treap ordered by start day. every node knows the first and last start,
+// the last busy day and the longest gap of its subtree, so overlap checks, "next free slot of length d" and putting
+// a task on or taking it off the schedule are all O(log n) in the user's task count
+// a gap is the free days between the last busy day of every task before it and the start of the next task. fixed
+// tasks may overlap, and then a subtree's gap can be longer than it is given what comes before it, which only costs
+// looking into that subtree for nothing. a zero duration task still blocks its start day, same as the original check
+
+uint64_t schedule_busy_task_end(Task* task){
+  if (task->day_end < task->day_start){
+    return task->day_start;
+  }
+  return task->day_end;
+}
+
+
+// first day that could be free after a task busy up to end. a task that runs to the end of time leaves none
+uint64_t schedule_busy_after(uint64_t end){
+  if (end == UINT64_MAX){
+    return UINT64_MAX;
+  }
+  return end + 1;
+}
+
+
+// free days from first up to the day before start, 0 if none
+uint64_t schedule_busy_gap(uint64_t first, uint64_t start){
+  if (start > first){
+    return start - first;
+  }
+  return 0;
+}
+
+
+// recompute a node's subtree fields from its own task and its children
+void schedule_busy_node_update(Schedule_Busy_Node* node){
+  Schedule_Busy_Node* before = node->child[0];
+  Schedule_Busy_Node* after = node->child[1];
+  uint64_t start = node->task->day_start;
+  uint64_t end = schedule_busy_task_end(node->task);
+  node->start_min = start;
+  node->start_max = start;
+  node->end_max = end;
+  node->gap_max = 0;
+  if (before != NULL){
+    node->start_min = before->start_min;
+    node->gap_max = before->gap_max;
+    uint64_t gap = schedule_busy_gap(schedule_busy_after(before->end_max), start);
+    if (gap > node->gap_max){
+      node->gap_max = gap;
+    }
+    if (before->end_max > node->end_max){
+      node->end_max = before->end_max;
+    }
+  }
+  if (after != NULL){
+    node->start_max = after->start_max;
+    if (after->gap_max > node->gap_max){
+      node->gap_max = after->gap_max;
+    }
+    uint64_t gap = schedule_busy_gap(schedule_busy_after(node->end_max), after->start_min);
+    if (gap > node->gap_max){
+      node->gap_max = gap;
+    }
+    if (after->end_max > node->end_max){
+      node->end_max = after->end_max;
+    }
+  }
+}
+
+
+// tasks are ordered by start day, then by where their node is in memory, so every node has its own place
+int schedule_busy_node_before(Schedule_Busy_Node* a, Schedule_Busy_Node* b){
+  if (a->task->day_start != b->task->day_start){
+    return (a->task->day_start < b->task->day_start);
+  }
+  return (a < b);
+}
+
+
+// lift node's child on side dir above it. returns the new top of the subtree
+Schedule_Busy_Node* schedule_busy_node_rotate(Schedule_Busy_Node* node, int dir){
+  Schedule_Busy_Node* child = node->child[dir];
+  node->child[dir] = child->child[!dir];
+  child->child[!dir] = node;
+  schedule_busy_node_update(node);
+  schedule_busy_node_update(child);
+  return child;
+}
+
+
+Schedule_Busy_Node* schedule_busy_node_insert(Schedule_Busy_Node* root, Schedule_Busy_Node* node){
+  if (root == NULL){
+    return node;
+  }
+  int dir = (schedule_busy_node_before(node, root) == TRUE) ? 0 : 1;
+  root->child[dir] = schedule_busy_node_insert(root->child[dir], node);
+  if (root->child[dir]->priority > root->priority){
+    return schedule_busy_node_rotate(root, dir);
+  }
+  schedule_busy_node_update(root);
+  return root;
+}
+
+
+// join two subtrees, everything in a before everything in b
+Schedule_Busy_Node* schedule_busy_node_join(Schedule_Busy_Node* a, Schedule_Busy_Node* b){
+  if (a == NULL){
+    return b;
+  }
+  if (b == NULL){
+    return a;
+  }
+  if (a->priority > b->priority){
+    a->child[1] = schedule_busy_node_join(a->child[1], b);
+    schedule_busy_node_update(a);
+    return a;
+  }
+  b->child[0] = schedule_busy_node_join(a, b->child[0]);
+  schedule_busy_node_update(b);
+  return b;
+}
+
+
+Schedule_Busy_Node* schedule_busy_node_remove(Schedule_Busy_Node* root, Schedule_Busy_Node* node){
+  assert(root != NULL);
+  if (root == node){
+    return schedule_busy_node_join(node->child[0], node->child[1]);
+  }
+  int dir = (schedule_busy_node_before(node, root) == TRUE) ? 0 : 1;
+  root->child[dir] = schedule_busy_node_remove(root->child[dir], node);
+  schedule_busy_node_update(root);
+  return root;
+}
+
+
+void schedule_busy_clear(User* user){
+  user->schedule_busy_root = NULL;
+  user->schedule_busy_qty = 0;
+  user->schedule_busy_seed = 2463534242;
+}
+
+
+// node is the task's own node for this user, see Task.schedule_busy_nodes
+void schedule_busy_insert(User* user, Schedule_Busy_Node* node, Task* task){
+  // xorshift, any spread of priorities keeps the tree shallow
+  user->schedule_busy_seed ^= user->schedule_busy_seed << 13;
+  user->schedule_busy_seed ^= user->schedule_busy_seed >> 17;
+  user->schedule_busy_seed ^= user->schedule_busy_seed << 5;
+  node->task = task;
+  node->child[0] = NULL;
+  node->child[1] = NULL;
+  node->priority = user->schedule_busy_seed;
+  schedule_busy_node_update(node);
+  user->schedule_busy_root = schedule_busy_node_insert(user->schedule_busy_root, node);
+  user->schedule_busy_qty += 1;
+}
+
+
+// task->day_start must not have changed since it was inserted
+void schedule_busy_remove(User* user, Schedule_Busy_Node* node){
+  user->schedule_busy_root = schedule_busy_node_remove(user->schedule_busy_root, node);
+  user->schedule_busy_qty -= 1;
+}
+
+
+// TRUE if any scheduled task of this user overlaps [start, start+duration-1]
+int schedule_busy_conflict(User* user, uint64_t start, uint64_t duration){
+  uint64_t end = start;
+  if (duration > 0){
+    end = start + duration - 1;
+  }
+  // the last busy day of the tasks that start on or before end
+  Schedule_Busy_Node* node = user->schedule_busy_root;
+  while (node != NULL){
+    if (node->task->day_start <= end){
+      if (schedule_busy_task_end(node->task) >= start){
+        return TRUE;
+      }
+      if ((node->child[0] != NULL) && (node->child[0]->end_max >= start)){
+        return TRUE;
+      }
+      node = node->child[1];
+    }
+    else{
+      node = node->child[0];
+    }
+  }
+  return FALSE;
+}
+
+
+// earliest day no sooner than start with duration free days, in the gaps before the tasks of this subtree. *free_day
+// is the first free day after the tasks before it, and moves past the subtree when there's no room in it. UINT64_MAX
+// if none
+uint64_t schedule_busy_node_first(Schedule_Busy_Node* node, uint64_t* free_day, uint64_t start, uint64_t duration){
+  if (node == NULL){
+    return UINT64_MAX;
+  }
+  uint64_t first = (*free_day > start) ? *free_day : start;
+  if ((schedule_busy_gap(first, node->start_max) < duration) ||
+      ((node->gap_max < duration) && (schedule_busy_gap(first, node->start_min) < duration))){
+    if (schedule_busy_after(node->end_max) > *free_day){
+      *free_day = schedule_busy_after(node->end_max);
+    }
+    return UINT64_MAX;
+  }
+
+  uint64_t fit = schedule_busy_node_first(node->child[0], free_day, start, duration);
+  if (fit != UINT64_MAX){
+    return fit;
+  }
+  first = (*free_day > start) ? *free_day : start;
+  if (schedule_busy_gap(first, node->task->day_start) >= duration){
+    return first;
+  }
+  if (schedule_busy_after(schedule_busy_task_end(node->task)) > *free_day){
+    *free_day = schedule_busy_after(schedule_busy_task_end(node->task));
+  }
+  return schedule_busy_node_first(node->child[1], free_day, start, duration);
+}
+
+
+// latest day no later than start with duration free days, in the gaps before the tasks of this subtree. free_day is the
+// first free day after the tasks before it. UINT64_MAX if none
+uint64_t schedule_busy_node_last(Schedule_Busy_Node* node, uint64_t free_day, uint64_t start, uint64_t duration){
+  if (node == NULL){
+    return UINT64_MAX;
+  }
+  if ((start < free_day) || (schedule_busy_gap(free_day, node->start_max) < duration) ||
+      ((node->gap_max < duration) && (schedule_busy_gap(free_day, node->start_min) < duration))){
+    return UINT64_MAX;
+  }
+
+  uint64_t free_here = free_day;
+  if ((node->child[0] != NULL) && (schedule_busy_after(node->child[0]->end_max) > free_here)){
+    free_here = schedule_busy_after(node->child[0]->end_max);
+  }
+  uint64_t free_after = free_here;
+  if (schedule_busy_after(schedule_busy_task_end(node->task)) > free_after){
+    free_after = schedule_busy_after(schedule_busy_task_end(node->task));
+  }
+  uint64_t fit = schedule_busy_node_last(node->child[1], free_after, start, duration);
+  if (fit != UINT64_MAX){
+    return fit;
+  }
+  if (node->task->day_start >= duration){
+    fit = node->task->day_start - duration;
+    if (fit > start){
+      fit = start;
+    }
+    if (fit >= free_here){
+      return fit;
+    }
+  }
+  return schedule_busy_node_last(node->child[0], free_day, start, duration);
+}
+
+
+// earliest start day, no sooner than start, where this user is free for duration days
+// returns UINT64_MAX if there is no room, only when a task runs to the end of time
+uint64_t schedule_busy_fit_forward(User* user, uint64_t start, uint64_t duration){
+  if (duration == 0){
+    duration = 1;
+  }
+  uint64_t free_day = 0;
+  uint64_t fit = schedule_busy_node_first(user->schedule_busy_root, &free_day, start, duration);
+  if (fit == UINT64_MAX){
+    // after every task, open ended
+    fit = (free_day > start) ? free_day : start;
+  }
+  return fit;
+}
+
+
+// latest start day, no later than start, where this user is free for duration days
+// returns UINT64_MAX if there is no room before start
+uint64_t schedule_busy_fit_backward(User* user, uint64_t start, uint64_t duration){
+  if (duration == 0){
+    duration = 1;
+  }
+  Schedule_Busy_Node* root = user->schedule_busy_root;
+  if ((root == NULL) || (start > root->end_max)){
+    return start;
+  }
+  return schedule_busy_node_last(root, 0, start, duration);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// READY SET
+// every task keeps a count of its unscheduled prereqs and dependents. scheduling or unscheduling a task only touches
+// its neighbors, and the ready/pending bitsets let the DFS visit candidates in task order without scanning everything
+
+size_t schedule_ready_words(size_t allocation_total){
+  return (allocation_total + 63) / 64;
+}
+
+
+void schedule_bit_set(uint64_t* bits, size_t index, uint8_t value){
+  if (value == TRUE){
+    bits[index / 64] |= ((uint64_t) 1 << (index % 64));
+  }
+  else{
+    bits[index / 64] &= ~((uint64_t) 1 << (index % 64));
+  }
+}
+
+
+uint8_t schedule_bit_get(uint64_t* bits, size_t index){
+  if ((bits[index / 64] >> (index % 64)) & 1){
+    return TRUE;
+  }
+  return FALSE;
+}
+
+
+// index of the first set bit at or after start, or allocation_total if there are none
+size_t schedule_bit_next(uint64_t* bits, size_t allocation_total, size_t start){
+  if (start >= allocation_total){
+    return allocation_total;
+  }
+  size_t word = start / 64;
+  uint64_t remaining = bits[word] & (~(uint64_t) 0 << (start % 64));
+  size_t words = schedule_ready_words(allocation_total);
+  while (remaining == 0){
+    word += 1;
+    if (word >= words){
+      return allocation_total;
+    }
+    remaining = bits[word];
+  }
+  return word*64 + __builtin_ctzll(remaining);
+}
+
+
+// recompute whether a single task can be scheduled next
+void schedule_ready_update(Task_Memory* task_memory, Task* task){
+  uint8_t ready = FALSE;
+  if ((task->trash == FALSE) && (task->schedule_done == FALSE)){
+    if ((task->prereq_qty > 0) && (task->schedule_prereq_remaining == 0)){
+      ready = TRUE;
+    }
+    if ((task->dependent_qty > 0) && (task->schedule_dependent_remaining == 0)){
+      ready = TRUE;
+    }
+  }
+  schedule_bit_set(task_memory->schedule_ready, task - task_memory->tasks, ready);
+}
+
+
+// clear all scheduling results, reset the counters and the bitsets
+void schedule_ready_init(Task_Memory* task_memory){
+  size_t words = schedule_ready_words(task_memory->allocation_total);
+  memset(task_memory->schedule_ready, 0, words * sizeof(uint64_t));
+  memset(task_memory->schedule_pending, 0, words * sizeof(uint64_t));
+
+  for (size_t t=0; t<task_memory->allocation_total; ++t){
+    Task* task = task_memory->tasks + t;
+    task->schedule_done = FALSE;
+    if (task->trash == FALSE){
+      // prereqs may still point at a task that was just deleted, don't wait on those
+      task->schedule_prereq_remaining = 0;
+      for (size_t i=0; i<task->prereq_qty; ++i){
+        if (task->prereqs[i]->trash == FALSE){
+          task->schedule_prereq_remaining += 1;
+        }
+      }
+      task->schedule_dependent_remaining = task->dependent_qty;
+      schedule_bit_set(task_memory->schedule_pending, t, TRUE);
+      schedule_ready_update(task_memory, task);
+
+      for (size_t u=0; u<task->user_qty; ++u){
+        schedule_busy_clear(task->users[u]);
+      }
+    }
+  }
+}
+
+
+void schedule_task_done_set(Task_Memory* task_memory, Task* task){
+  assert(task->schedule_done == FALSE);
+  task->schedule_done = TRUE;
+  schedule_bit_set(task_memory->schedule_pending, task - task_memory->tasks, FALSE);
+  schedule_ready_update(task_memory, task);
+  for (size_t u=0; u<task->user_qty; ++u){
+    schedule_busy_insert(task->users[u], task->schedule_busy_nodes + u, task);
+  }
+
+  for (size_t i=0; i<task->dependent_qty; ++i){
+    task->dependents[i]->schedule_prereq_remaining -= 1;
+    schedule_ready_update(task_memory, task->dependents[i]);
+  }
+  for (size_t i=0; i<task->prereq_qty; ++i){
+    if (task->prereqs[i]->trash == FALSE){
+      task->prereqs[i]->schedule_dependent_remaining -= 1;
+      schedule_ready_update(task_memory, task->prereqs[i]);
+    }
+  }
+}
+
+
+void schedule_task_done_clear(Task_Memory* task_memory, Task* task){
+  assert(task->schedule_done == TRUE);
+  task->schedule_done = FALSE;
+  schedule_bit_set(task_memory->schedule_pending, task - task_memory->tasks, TRUE);
+  schedule_ready_update(task_memory, task);
+  for (size_t u=0; u<task->user_qty; ++u){
+    schedule_busy_remove(task->users[u], task->schedule_busy_nodes + u);
+  }
+
+  for (size_t i=0; i<task->dependent_qty; ++i){
+    task->dependents[i]->schedule_prereq_remaining += 1;
+    schedule_ready_update(task_memory, task->dependents[i]);
+  }
+  for (size_t i=0; i<task->prereq_qty; ++i){
+    if (task->prereqs[i]->trash == FALSE){
+      task->prereqs[i]->schedule_dependent_remaining += 1;
+      schedule_ready_update(task_memory, task->prereqs[i]);
+    }
+  }
+}
+
+
 // TODO return the number of conflicting days? e.g. the number of days you need to move the task for it to be OK to schedule
 int schedule_conflict_detect(Task* proposed_task){
-  int conflict_detected = FALSE;
-
-  // look at the users of the task being scheduled
+  // look at the users of the task being scheduled, and their already scheduled tasks
   for (size_t u=0; u<proposed_task->user_qty; ++u){
-    User* user = proposed_task->users[u];
+    if (schedule_busy_conflict(proposed_task->users[u], proposed_task->day_start, proposed_task->day_duration) == TRUE){
+      return TRUE;
+    }
+  }
+  return FALSE;
+}
 
-    // search through every (other) task assigned to those users
-    for (size_t t=0; t<user->task_qty; ++t){
-      Task* scheduled_task = user->tasks[t];
 
-      if (scheduled_task->schedule_done == TRUE){
-        // detect if there is any conflict between the proposed task and previously scheduled tasks
-        if (proposed_task->day_start > scheduled_task->day_start){
-          if (proposed_task->day_start <= scheduled_task->day_end){
-            conflict_detected = TRUE;
-          }
-        }
-        else if (proposed_task->day_start < scheduled_task->day_start){
-          if (proposed_task->day_end >= scheduled_task->day_start){
-            conflict_detected = TRUE;
-          }
-        }
-        else{
-          conflict_detected = TRUE;
-        }
+// closest start day to start, in direction dir, where all of the task's users are free for the whole task
+// each user jumps straight to their next gap, repeat until every user agrees. UINT64_MAX if there is no room
+uint64_t schedule_user_fit(Task* task, uint64_t start, int dir, Schedule_Stats* stats){
+  int moved = TRUE;
+  while (moved == TRUE){
+    moved = FALSE;
+    for (size_t u=0; u<task->user_qty; ++u){
+      uint64_t fit;
+      stats->conflict_checks += 1;
+      if (dir > 0){
+        fit = schedule_busy_fit_forward(task->users[u], start, task->day_duration);
+      }
+      else{
+        fit = schedule_busy_fit_backward(task->users[u], start, task->day_duration);
+      }
+      if (fit == UINT64_MAX){
+        return UINT64_MAX;
+      }
+      if (fit != start){
+        start = fit;
+        moved = TRUE;
+        stats->shift_iterations += 1;
       }
     }
   }
-   
-  return conflict_detected;
+  return start;
 }
 
 
-int schedule_task_push(Schedule_Event_List* schedule_working, Task* task, int schedule_shift_dir){
+int schedule_task_push(Task_Memory* task_memory, Schedule_Event_List* schedule_working, Task* task, int schedule_shift_dir){
   // figure out when this task is getting scheduled
   // depends on whether it is added by dependency or prerequisite. EXCEPT for user busyness!!
   // if added by prerequisite.. search forwards. from prerequisite day end to the earliest point when all users are available
   // if added by dependency... search backwards. 
   // need to make sure the entire block of user time is available
-  // push the task farther in the scheduling direction until conflict is resolved, one day at a time
+  // push the task farther in the scheduling direction until conflict is resolved, jumping gap to gap
   //
   // only add a task to ready once all of its prereqs or dependents are scheduled. add to ready with a suggested date
   // use task->schedule_seek_direction to know which way to try and adjust a task to make it work. 
@@ -331,6 +1217,8 @@ int schedule_task_push(Schedule_Event_List* schedule_working, Task* task, int sc
 
   // try and find a time to put this task
   // guess a time based on earliest/latest possible from the prereq/dependent list
+  uint64_t day_start_previous = task->day_start;
+  uint64_t day_end_previous = task->day_end;
   uint64_t start;
   if (schedule_shift_dir == 1){ // prerequisites have been met (schedule after)
     start = 0;
@@ -355,29 +1243,32 @@ int schedule_task_push(Schedule_Event_List* schedule_working, Task* task, int sc
     assert(0);
   }
 
-  // while scheduling conflict exists shift task in direction indicated by schedule_shift_dir
-  task->day_start = start;
-  task->day_end = task->day_start + task->day_duration - 1;
-  //printf("[SCHEDULER] initial guess puts task %s at day %lu - %lu\n", task->task_name, task->day_start, task->day_end); 
-
-  size_t loop_counter = 0;
-  while (schedule_conflict_detect(task) == TRUE){
-    //printf("  conflict adjustment...\n");
-    task->day_start += schedule_shift_dir;
-    task->day_end = task->day_start + task->day_duration - 1;
+  // never outside the start window, see schedule_windows_prepare()
+  uint64_t seek = start;
+  if ((schedule_shift_dir == 1) && (seek < task->schedule_earliest_start)){
+    seek = task->schedule_earliest_start;
+  }
+  else if ((schedule_shift_dir == -1) && (seek > task->schedule_latest_start)){
+    seek = task->schedule_latest_start;
+  }
 
-    // TODO handle detect infinite loop problems??
-    if (loop_counter > 1e4){
-      printf("[WARNING] scheduling task shift loop counter exceeded\n");
-      return FAILURE;
-    }
+  // if the users are busy, jump in the direction indicated by schedule_shift_dir to the first window where they are all free
+  task->day_start = schedule_user_fit(task, seek, schedule_shift_dir, &schedule_working->stats);
+  if ((task->day_start == UINT64_MAX) || (task->day_start < task->schedule_earliest_start) || (task->day_start > task->schedule_latest_start)){
+    schedule_working->stats.failed_pushes += 1;
+    return FAILURE;
+  }
+  task->day_end = task->day_start + task->day_duration - 1;
+  //printf("[SCHEDULER] initial guess puts task %s at day %lu - %lu\n", task->task_name, start, start + task->day_duration - 1);
 
+  if (task->day_start != start){
     // verify that prereqs and dependencies are still being met
     if (schedule_shift_dir > 0){
       // check against scheduled dependents
       for (size_t t=0; t<task->dependent_qty; ++t){
         if (task->dependents[t]->schedule_done == TRUE){
           if (task->day_end >= task->dependents[t]->day_start){
+            schedule_working->stats.failed_pushes += 1;
             return FAILURE;
           }
         }
@@ -388,6 +1279,7 @@ int schedule_task_push(Schedule_Event_List* schedule_working, Task* task, int sc
       for (size_t t=0; t<task->prereq_qty; ++t){
         if (task->prereqs[t]->schedule_done == TRUE){
           if (task->day_start <= task->prereqs[t]->day_end){
+            schedule_working->stats.failed_pushes += 1;
             return FAILURE;
           }
         }
@@ -397,31 +1289,217 @@ int schedule_task_push(Schedule_Event_List* schedule_working, Task* task, int sc
   // printf("[SCHEDULER] after conflict adjustment task %s at day %lu - %lu\n", task->task_name, task->day_start, task->day_end); 
 
   // store the task solution so it can be recreated later out of the best task
-  schedule_working->qty += 1;
-  schedule_memory_management(schedule_working);
-  schedule_working->events[schedule_working->qty-1].task = task;
-  schedule_working->events[schedule_working->qty-1].date = task->day_start;
-  task->schedule_done = TRUE;
+  schedule_event_add(schedule_working, task);
+  schedule_working->events[schedule_working->qty - 1].day_start_previous = day_start_previous;
+  schedule_working->events[schedule_working->qty - 1].day_end_previous = day_end_previous;
+  schedule_task_done_set(task_memory, task);
 
   return SUCCESS;
 }
 
 
 // remove the last value from the list of scheduled tasks
-int schedule_task_pop(Schedule_Event_List* schedule_working){
+int schedule_task_pop(Task_Memory* task_memory, Schedule_Event_List* schedule_working){
   assert(schedule_working->qty > 0);
   schedule_working->qty -= 1;
-  Task* task = schedule_working->events[schedule_working->qty].task;
-  task->schedule_done = FALSE;
+  Schedule_Event* event = schedule_working->events + schedule_working->qty;
+  Task* task = event->task;
+  schedule_task_done_clear(task_memory, task);
+  task->day_start = event->day_start_previous;
+  task->day_end = event->day_end_previous;
+  schedule_working->stats.backtracks += 1;
   return SUCCESS;
 }
 
 
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// PARALLEL SEARCH
+// the DFS works on the task dates and done flags in place, so one search can't be shared between threads directly.
+// instead each thread gets its own packed copy of the project, and a subtree travels between threads as a job:
+// the event list that leads to it plus every task date. the DFS reads dates left behind by earlier branches too.
+// each thread keeps a deque of jobs. it works from the bottom, and idle threads steal from the top, where the
+// jobs are oldest and their subtrees biggest. a thread only splits off work while another is idle, and an idle
+// thread sleeps until some job is shared or the search is over
+
+#define SCHEDULE_SEARCH_THREADS_MAX 64
+#define SCHEDULE_SEARCH_DEQUE_MAX 256
+
+typedef struct Schedule_Search_Job{
+  size_t event_qty;
+  size_t* event_task; // packed task index of each event, in order
+  uint64_t* day_start; // every task, scheduled or not
+  uint64_t* day_end;
+} Schedule_Search_Job;
+
+typedef struct Schedule_Search_Deque{
+  Schedule_Search_Job* jobs[SCHEDULE_SEARCH_DEQUE_MAX];
+  size_t top; // thieves take from here
+  size_t bottom; // the owner pushes and pops here
+  SDL_SpinLock lock;
+} Schedule_Search_Deque;
+
+typedef struct Schedule_Search_Worker{
+  struct Schedule_Search* search;
+  struct Schedule_Island* copy; // this thread's tasks, users, best and working schedules
+  Schedule_Search_Deque deque;
+  size_t index;
+} Schedule_Search_Worker;
+
+typedef struct Schedule_Search{
+  Schedule_Search_Worker workers[SCHEDULE_SEARCH_THREADS_MAX];
+  size_t qty;
+  SDL_atomic_t outstanding; // jobs handed out and not yet searched to the end
+  SDL_atomic_t hungry; // threads without a job
+  SDL_atomic_t incumbent; // best duration across every thread
+  SDL_mutex* idle_lock;
+  SDL_cond* work; // signalled when a job is shared, broadcast when the last job is done
+} Schedule_Search;
+
+
+// capture the current search state as a job
+Schedule_Search_Job* schedule_search_job_take(Task_Memory* task_memory, Schedule_Event_List* schedule_working){
+  Schedule_Search_Job* job = (Schedule_Search_Job*) malloc(sizeof(Schedule_Search_Job));
+  job->event_qty = schedule_working->qty;
+  job->event_task = (size_t*) malloc(job->event_qty * sizeof(size_t));
+  job->day_start = (uint64_t*) malloc(task_memory->allocation_total * sizeof(uint64_t));
+  job->day_end = (uint64_t*) malloc(task_memory->allocation_total * sizeof(uint64_t));
+  for (size_t e=0; e<job->event_qty; ++e){
+    job->event_task[e] = schedule_working->events[e].task - task_memory->tasks;
+  }
+  for (size_t t=0; t<task_memory->allocation_total; ++t){
+    job->day_start[t] = task_memory->tasks[t].day_start;
+    job->day_end[t] = task_memory->tasks[t].day_end;
+  }
+  return job;
+}
+
+
+// put the search state back the way it was when the job was taken. the event dates are the task dates
+void schedule_search_job_restore(Task_Memory* task_memory, Schedule_Event_List* schedule_working, Schedule_Search_Job* job){
+  schedule_working->qty = 0;
+  schedule_working->solved = FALSE;
+  schedule_ready_init(task_memory);
+  for (size_t t=0; t<task_memory->allocation_total; ++t){
+    task_memory->tasks[t].day_start = job->day_start[t];
+    task_memory->tasks[t].day_end = job->day_end[t];
+  }
+  for (size_t e=0; e<job->event_qty; ++e){
+    Task* task = task_memory->tasks + job->event_task[e];
+    schedule_task_done_set(task_memory, task);
+    schedule_event_add(schedule_working, task);
+  }
+}
+
+
+void schedule_search_job_free(Schedule_Search_Job* job){
+  free(job->event_task);
+  free(job->day_start);
+  free(job->day_end);
+  free(job);
+}
+
+
+size_t schedule_search_deque_size(Schedule_Search_Deque* deque){
+  SDL_AtomicLock(&deque->lock);
+  size_t size = deque->bottom - deque->top;
+  SDL_AtomicUnlock(&deque->lock);
+  return size;
+}
+
+
+void schedule_search_deque_push(Schedule_Search_Deque* deque, Schedule_Search_Job* job){
+  SDL_AtomicLock(&deque->lock);
+  assert(deque->bottom - deque->top < SCHEDULE_SEARCH_DEQUE_MAX);
+  deque->jobs[deque->bottom % SCHEDULE_SEARCH_DEQUE_MAX] = job;
+  deque->bottom += 1;
+  SDL_AtomicUnlock(&deque->lock);
+}
+
+
+// the newest job, for the owner. NULL if empty
+Schedule_Search_Job* schedule_search_deque_pop(Schedule_Search_Deque* deque){
+  Schedule_Search_Job* job = NULL;
+  SDL_AtomicLock(&deque->lock);
+  if (deque->bottom > deque->top){
+    deque->bottom -= 1;
+    job = deque->jobs[deque->bottom % SCHEDULE_SEARCH_DEQUE_MAX];
+  }
+  SDL_AtomicUnlock(&deque->lock);
+  return job;
+}
+
+
+// the oldest job, for a thief. NULL if empty
+Schedule_Search_Job* schedule_search_deque_steal(Schedule_Search_Deque* deque){
+  Schedule_Search_Job* job = NULL;
+  SDL_AtomicLock(&deque->lock);
+  if (deque->bottom > deque->top){
+    job = deque->jobs[deque->top % SCHEDULE_SEARCH_DEQUE_MAX];
+    deque->top += 1;
+  }
+  SDL_AtomicUnlock(&deque->lock);
+  return job;
+}
+
+
+// offer the subtree under the current state to the other threads. TRUE if it was taken as a job
+int schedule_search_share(Task_Memory* task_memory, Schedule_Event_List* schedule_working){
+  Schedule_Search_Worker* worker = schedule_working->search;
+  // the last few tasks aren't worth the copy
+  if (task_memory->allocation_used - schedule_working->qty < 3){
+    return FALSE;
+  }
+  int hungry = SDL_AtomicGet(&worker->search->hungry);
+  if ((hungry == 0) || (schedule_search_deque_size(&worker->deque) >= (size_t) hungry)){
+    return FALSE;
+  }
+  SDL_AtomicAdd(&worker->search->outstanding, 1);
+  schedule_search_deque_push(&worker->deque, schedule_search_job_take(task_memory, schedule_working));
+  SDL_LockMutex(worker->search->idle_lock);
+  SDL_CondSignal(worker->search->work);
+  SDL_UnlockMutex(worker->search->idle_lock);
+  return TRUE;
+}
+
+
+// which way a ready task is placed: after its prereqs if they are all scheduled, they take priority when both are,
+// otherwise before its dependents
+int schedule_ready_dir(Task* task){
+  if ((task->prereq_qty > 0) && (task->schedule_prereq_remaining == 0)){
+    return 1;
+  }
+  return -1;
+}
+
+
 // attempt to continue scheduling by adding a task to the schedule
 // no island tasks allowed.. every task must either have fixed_i or a prereq
 // how do you know when you are done? when all non trash tasks are scheduled
 // how do you know when to give up? TODO
 void schedule_solve_iter(Task_Memory* task_memory, Schedule_Event_List* schedule_best, Schedule_Event_List* schedule_working){
+  // the model changed under us, or out of time
+  if (schedule_search_stop(schedule_working) == TRUE){
+    return;
+  }
+
+  // give up on this branch if it can't possibly be better than the best so far
+  if ((schedule_working->solver == SCHEDULE_SOLVER_DFS_BOUNDED) && (schedule_best->solved == TRUE)){
+    if (schedule_lower_bound(schedule_working) >= (int64_t) schedule_best->day_duration){
+      schedule_working->search_prunes += 1;
+      return;
+    }
+  }
+  // or the best any other search in the portfolio has found
+  if ((schedule_working->solver == SCHEDULE_SOLVER_DFS_BOUNDED) && (schedule_working->incumbent != NULL)){
+    if (schedule_lower_bound(schedule_working) >= (int64_t) SDL_AtomicGet(schedule_working->incumbent)){
+      schedule_working->search_prunes += 1;
+      return;
+    }
+  }
+  schedule_working->search_nodes += 1;
+  if (schedule_working->qty > schedule_working->stats.depth_max){
+    schedule_working->stats.depth_max = schedule_working->qty;
+  }
 
   // quit when all tasks have been scheduled
   if (task_memory->allocation_used - schedule_working->qty == 0){
@@ -445,11 +1523,11 @@ void schedule_solve_iter(Task_Memory* task_memory, Schedule_Event_List* schedule
 
       if (schedule_best->solved == FALSE){
         //printf("[SCHEDULER] FIRST SOLVE\n");
-        schedule_copy(schedule_best, schedule_working);
+        schedule_improved(task_memory, schedule_best, schedule_working);
       }
       else if (schedule_working->day_duration < schedule_best->day_duration){
         //printf("[SCHEDULER] A BETTER SOLVE THAN BEFORE :)\n");
-        schedule_copy(schedule_best, schedule_working);
+        schedule_improved(task_memory, schedule_best, schedule_working);
       }
       else{
         // not a winner
@@ -461,163 +1539,2397 @@ void schedule_solve_iter(Task_Memory* task_memory, Schedule_Event_List* schedule
   }
 
   // try to schedule a task that has all dependents or prereqs scheduled
-  for (size_t t=0; t<task_memory->allocation_total; ++t){
+  size_t total = task_memory->allocation_total;
+  for (size_t t=schedule_bit_next(task_memory->schedule_ready, total, 0); t<total; t=schedule_bit_next(task_memory->schedule_ready, total, t+1)){
     Task* task = task_memory->tasks+t;
+    // printf("[SCHEDULER] considering task '%s'..\n", task->task_name);
 
-    if ((task->trash == FALSE) & (task->schedule_done == FALSE)){
-      // printf("[SCHEDULER] considering task '%s'..\n", task->task_name);
-      int schedule_shift_dir = 0;
+    int schedule_shift_dir = schedule_ready_dir(task);
+    // printf("       adding to the schedule\n");
+    int pushed = schedule_task_push(task_memory, schedule_working, task, schedule_shift_dir);
+    if (pushed == FAILURE){ // is this the right option? will there be an infinite loop?
+      continue;
+    }
 
-      // detect if all dependents are scheduled
-      if (task->dependent_qty > 0){
-        size_t dependents_scheduled = 0;
-        for (size_t i=0; i<task->dependent_qty; ++i){
-          if (task->dependents[i]->schedule_done == TRUE){
-            ++dependents_scheduled;
-          }
+    // hand the subtree to an idle thread instead of searching it here
+    if ((schedule_working->search != NULL) && (schedule_search_share(task_memory, schedule_working) == TRUE)){
+      schedule_task_pop(task_memory, schedule_working);
+      continue;
+    }
+
+    // recursion
+    schedule_solve_iter(task_memory, schedule_best, schedule_working);
+
+    // printf("   back up a level\n");
+
+    // if you come out of that.. then that path was no good or looking for an alternate solution
+    schedule_task_pop(task_memory, schedule_working);
+  }
+
+  // if this point is reached, it means it was impossible to schedule without making any guesses
+  // just guess each non schedule task at a time, and try to schedule
+  for (size_t t=schedule_bit_next(task_memory->schedule_pending, total, 0); t<total; t=schedule_bit_next(task_memory->schedule_pending, total, t+1)){
+    Task* task = task_memory->tasks + t;
+    // printf("Activating the schedule guess function! adding %s\n", task->task_name);
+
+    // see if it is better to post or pre schedule
+    int schedule_shift_dir = 1;
+    if (task->schedule_dependent_remaining < task->schedule_prereq_remaining){
+      schedule_shift_dir = -1;
+    }
+
+    // a ready task pushed the same way as above would only search the same subtree again
+    if ((schedule_bit_get(task_memory->schedule_ready, t) == TRUE) && (schedule_shift_dir == schedule_ready_dir(task))){
+      continue;
+    }
+
+    // same as above: a failed push left nothing on the schedule, a successful one is taken back after the recursion
+    int pushed = schedule_task_push(task_memory, schedule_working, task, schedule_shift_dir);
+    if (pushed == FAILURE){
+      continue;
+    }
+
+    if ((schedule_working->search != NULL) && (schedule_search_share(task_memory, schedule_working) == TRUE)){
+      schedule_task_pop(task_memory, schedule_working);
+      continue;
+    }
+
+    // recursion
+    schedule_solve_iter(task_memory, schedule_best, schedule_working);
+    schedule_task_pop(task_memory, schedule_working);
+  } // end testing each possible alternate task
+
+  // islands are split off before the search starts, see schedule_solve_islands()
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// LIST SCHEDULER
+// serial schedule generation; repeatedly take the highest priority task whose prereqs are all scheduled
+// and put it at the earliest day its prereqs and users allow. never backtracks, so the result is valid but
+// not necessarily the shortest. O(T log T + E) plus the user availability checks
+
+typedef struct Schedule_Heap {
+  Task** tasks;
+  size_t qty;
+  uint8_t solver; // selects the priority rule
+} Schedule_Heap;
+
+
+// TRUE if task a should be scheduled before task b
+int schedule_heap_before(Schedule_Heap* heap, Task* a, Task* b){
+  if (heap->solver == SCHEDULE_SOLVER_LIST_FINISH){
+    if (a->schedule_latest_finish != b->schedule_latest_finish){
+      return a->schedule_latest_finish < b->schedule_latest_finish;
+    }
+  }
+  if (a->schedule_path_length != b->schedule_path_length){
+    return a->schedule_path_length > b->schedule_path_length;
+  }
+  return a < b; // memory order as the last tie break, so results are repeatable
+}
+
+
+void schedule_heap_push(Schedule_Heap* heap, Task* task){
+  size_t i = heap->qty;
+  heap->qty += 1;
+
+  // sift up
+  while (i > 0){
+    size_t parent = (i-1)/2;
+    if (schedule_heap_before(heap, task, heap->tasks[parent]) == FALSE){
+      break;
+    }
+    heap->tasks[i] = heap->tasks[parent];
+    i = parent;
+  }
+  heap->tasks[i] = task;
+}
+
+
+Task* schedule_heap_pop(Schedule_Heap* heap){
+  assert(heap->qty > 0);
+  Task* result = heap->tasks[0];
+  heap->qty -= 1;
+  Task* last = heap->tasks[heap->qty];
+
+  // sift down
+  size_t i = 0;
+  for(;;){
+    size_t child = 2*i + 1;
+    if (child >= heap->qty){
+      break;
+    }
+    if ((child+1 < heap->qty) && (schedule_heap_before(heap, heap->tasks[child+1], heap->tasks[child]) == TRUE)){
+      child += 1;
+    }
+    if (schedule_heap_before(heap, heap->tasks[child], last) == FALSE){
+      break;
+    }
+    heap->tasks[i] = heap->tasks[child];
+    i = child;
+  }
+  heap->tasks[i] = last;
+
+  return result;
+}
+
+
+// fill order[] with every active task such that prereqs always come before their dependents
+// returns the number of tasks ordered. less than task_memory->allocation_used means there is a dependency loop
+size_t schedule_topological_order(Task_Memory* task_memory, Task** order){
+  size_t* prereqs_waiting = (size_t*) malloc(task_memory->allocation_total * sizeof(size_t));
+  size_t qty = 0;
+  for (size_t t=0; t<task_memory->allocation_total; ++t){
+    Task* task = task_memory->tasks + t;
+    prereqs_waiting[t] = 0;
+    if (task->trash == FALSE){
+      for (size_t i=0; i<task->prereq_qty; ++i){
+        if (task->prereqs[i]->trash == FALSE){
+          prereqs_waiting[t] += 1;
         }
-        if (dependents_scheduled == task->dependent_qty){
-          // printf("       all dependents for %s are scheduled.\n", task->task_name);
-          schedule_shift_dir = -1;
+      }
+      if (prereqs_waiting[t] == 0){
+        order[qty] = task;
+        ++qty;
+      }
+    }
+  }
+
+  // order[] doubles as the queue
+  for (size_t i=0; i<qty; ++i){
+    Task* task = order[i];
+    for (size_t d=0; d<task->dependent_qty; ++d){
+      size_t index = task->dependents[d] - task_memory->tasks;
+      prereqs_waiting[index] -= 1;
+      if (prereqs_waiting[index] == 0){
+        order[qty] = task->dependents[d];
+        ++qty;
+      }
+    }
+  }
+
+  free(prereqs_waiting);
+  return qty;
+}
+
+
+// backwards pass. priorities come from the work remaining after each task
+// every dependent of a task in order[] must be in order[] too, or already have its priorities
+void schedule_list_priorities(Task** order, size_t order_qty){
+  for (size_t i=order_qty; i>0; i--){
+    Task* task = order[i-1];
+    uint64_t path = 0;
+    uint64_t latest_finish = UINT64_MAX;
+    if ((task->schedule_constraints & (SCHEDULE_CONSTRAINT_END | SCHEDULE_CONSTRAINT_START)) > 0){
+      latest_finish = task->day_end;
+    }
+    for (size_t d=0; d<task->dependent_qty; ++d){
+      Task* dependent = task->dependents[d];
+      if (dependent->schedule_path_length > path){
+        path = dependent->schedule_path_length;
+      }
+      if (dependent->schedule_latest_finish != UINT64_MAX){
+        // must end the day before the dependent's latest start
+        uint64_t limit = dependent->schedule_latest_finish - dependent->day_duration;
+        if (limit < latest_finish){
+          latest_finish = limit;
         }
       }
-      // detect if all prereqs are scheduled
-      if (task->prereq_qty > 0){
-        size_t prereqs_scheduled = 0;
-        for (size_t i=0; i<task->prereq_qty; ++i){
-          if (task->prereqs[i]->schedule_done == TRUE){
-            ++prereqs_scheduled;
+    }
+    task->schedule_path_length = path + task->day_duration;
+    task->schedule_latest_finish = latest_finish;
+  }
+}
+
+
+// topological order plus the list priorities of every task. returns FAILURE if the prereqs loop
+int schedule_list_prepare(Task_Memory* task_memory, Task** order, size_t* order_qty){
+  *order_qty = schedule_topological_order(task_memory, order);
+  if (*order_qty < task_memory->allocation_used){
+    return FAILURE;
+  }
+
+  schedule_list_priorities(order, *order_qty);
+  return SUCCESS;
+}
+
+
+// forwards pass. every unscheduled task goes in as soon as its prereqs allow, no sooner than its current day_start
+// fixed and frozen tasks are already scheduled and counted off their dependents
+void schedule_list_place(Task_Memory* task_memory, Schedule_Event_List* schedule_working, Task** order, size_t order_qty, uint8_t solver){
+  Schedule_Heap heap;
+  heap.tasks = (Task**) malloc(task_memory->allocation_used * sizeof(Task*));
+  heap.qty = 0;
+  heap.solver = solver;
+
+  for (size_t i=0; i<order_qty; ++i){
+    Task* task = order[i];
+    if ((task->schedule_done == FALSE) && (task->schedule_prereq_remaining == 0)){
+      schedule_heap_push(&heap, task);
+    }
+  }
+
+  while (heap.qty > 0){
+    Task* task = schedule_heap_pop(&heap);
+
+    uint64_t start = task->day_start;
+    if (start < task->schedule_earliest_start){
+      start = task->schedule_earliest_start;
+    }
+    for (size_t p=0; p<task->prereq_qty; ++p){
+      if ((task->prereqs[p]->trash == FALSE) && (task->prereqs[p]->day_end + 1 > start)){
+        start = task->prereqs[p]->day_end + 1;
+      }
+    }
+    task->day_start = schedule_user_fit(task, start, 1, &schedule_working->stats);
+    task->day_end = task->day_start + task->day_duration - 1;
+    schedule_event_add(schedule_working, task);
+    schedule_task_done_set(task_memory, task);
+
+    for (size_t d=0; d<task->dependent_qty; ++d){
+      Task* dependent = task->dependents[d];
+      if ((dependent->schedule_done == FALSE) && (dependent->schedule_prereq_remaining == 0)){
+        // a prereq listed twice shows up twice in the dependents list, only queue once
+        uint8_t queued = FALSE;
+        for (size_t e=0; e<d; ++e){
+          if (task->dependents[e] == dependent){
+            queued = TRUE;
           }
         }
-        if (prereqs_scheduled == task->prereq_qty){
-          // printf("       all prereqs for %s are scheduled.\n", task->task_name);
-          schedule_shift_dir = 1;
+        if (queued == FALSE){
+          schedule_heap_push(&heap, dependent);
         }
       }
+    }
+  }
 
-      // if either.. then try scheduling this task
-      if (schedule_shift_dir != 0){
-        // printf("       adding to the schedule\n");
-        int pushed = schedule_task_push(schedule_working, task_memory->tasks+t, schedule_shift_dir);
-        if (pushed == FAILURE){ // is this the right option? will there be an infinite loop?
-          continue;
-        }
+  free(heap.tasks);
+}
+
+
+// a fixed date task may have been overrun by its prereqs
+int schedule_list_validate(Task** order, size_t order_qty){
+  int valid = TRUE;
+  for (size_t i=0; i<order_qty; ++i){
+    Task* task = order[i];
+    for (size_t p=0; p<task->prereq_qty; ++p){
+      if ((task->prereqs[p]->trash == FALSE) && (task->day_start <= task->prereqs[p]->day_end)){
+        printf("[SCHEDULER] list solver: task %s can't start after prereq %s\n", task->task_name, task->prereqs[p]->task_name);
+        valid = FALSE;
+      }
+    }
+  }
+  return valid;
+}
 
-        // recursion
-        schedule_solve_iter(task_memory, schedule_best, schedule_working);
 
-        // printf("   back up a level\n");
+void schedule_solve_list(Task_Memory* task_memory, Schedule_Event_List* schedule_best, Schedule_Event_List* schedule_working, uint8_t solver){
+  Task** order = (Task**) malloc(task_memory->allocation_used * sizeof(Task*));
+  size_t order_qty;
+  if (schedule_list_prepare(task_memory, order, &order_qty) == FAILURE){
+    printf("[SCHEDULER] list solver found a prerequisite loop, giving up\n");
+    free(order);
+    return;
+  }
 
-        // if you come out of that.. then that path was no good or looking for an alternate solution
-        schedule_task_pop(schedule_working);
+  // tasks with no prereqs start together, early enough to meet the tightest fixed date
+  uint64_t origin = UINT64_MAX;
+  for (size_t i=0; i<order_qty; ++i){
+    Task* task = order[i];
+    if (task->schedule_done == TRUE){
+      if (task->day_start < origin){
+        origin = task->day_start;
+      }
+    }
+    else if ((task->prereq_qty == 0) && (task->schedule_latest_finish != UINT64_MAX)){
+      if (task->schedule_latest_finish - task->day_duration + 1 < origin){
+        origin = task->schedule_latest_finish - task->day_duration + 1;
       }
     }
   }
+  if (origin == UINT64_MAX){
+    time_t now;
+    time(&now);
+    origin = (uint64_t) now / 86400;
+  }
+
+  for (size_t i=0; i<order_qty; ++i){
+    if (order[i]->schedule_done == FALSE){
+      order[i]->day_start = origin;
+    }
+  }
+  schedule_list_place(task_memory, schedule_working, order, order_qty, solver);
+
+  schedule_working->solved = schedule_list_validate(order, order_qty);
+  if (schedule_working->solved == TRUE){
+    schedule_calculate_duration(schedule_working, task_memory);
+    schedule_improved(task_memory, schedule_best, schedule_working);
+  }
+
+  free(order);
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// BRANCH AND BOUND
+// the final schedule must hold the prereq and dependent chains hanging off of every scheduled task, and each user can
+// only work one task at a time. both give a lower bound on duration that the DFS can prune against
+
+// compute the chain lengths and user workloads that schedule_lower_bound() relies on
+// chains are measured like the final prereq check; a task may start on the day its prereq ends
+void schedule_bounds_prepare(Task_Memory* task_memory, Schedule_Event_List* schedule_working){
+  Task** order = (Task**) malloc(task_memory->allocation_used * sizeof(Task*));
+  size_t order_qty = schedule_topological_order(task_memory, order);
+  uint8_t loop_found = (order_qty < task_memory->allocation_used);
 
-  // if this point is reached, it means it was impossible to schedule without making any guesses
-  // just guess each non schedule task at a time, and try to schedule
   for (size_t t=0; t<task_memory->allocation_total; ++t){
     Task* task = task_memory->tasks + t;
-    
-    if ((task->trash == FALSE) && (task->schedule_done == FALSE)){
-      // printf("Activating the schedule guess function! adding %s\n", task->task_name);
+    task->schedule_bound_head = 0;
+    task->schedule_bound_tail = 0;
+    if (task->trash == FALSE){
+      for (size_t u=0; u<task->user_qty; ++u){
+        task->users[u]->schedule_workload = 0;
+      }
+    }
+  }
 
-      // see if it is better to post or pre schedule
-      int schedule_shift_dir = 0;
-      for (size_t t=0; t<task->dependent_qty; ++t){
-        if (task->dependents[t]->schedule_done == FALSE){
-          schedule_shift_dir += 1;
+  // prereq loops have no meaningful chain length, leave everything at zero
+  if (loop_found == FALSE){
+    for (size_t i=0; i<order_qty; ++i){
+      Task* task = order[i];
+      for (size_t p=0; p<task->prereq_qty; ++p){
+        Task* prereq = task->prereqs[p];
+        if (prereq->trash == FALSE){
+          int64_t head = prereq->schedule_bound_head + (int64_t) prereq->day_duration - 1;
+          if (head > task->schedule_bound_head){
+            task->schedule_bound_head = head;
+          }
         }
       }
-      for (size_t t=0; t<task->prereq_qty; ++t){
-        if (task->prereqs[t]->schedule_done == FALSE){
-          schedule_shift_dir -= 1;
+    }
+    for (size_t i=order_qty; i>0; i--){
+      Task* task = order[i-1];
+      for (size_t d=0; d<task->dependent_qty; ++d){
+        Task* dependent = task->dependents[d];
+        int64_t tail = dependent->schedule_bound_tail + (int64_t) dependent->day_duration - 1;
+        if (tail > task->schedule_bound_tail){
+          task->schedule_bound_tail = tail;
         }
       }
-      if (schedule_shift_dir >= 0){
-        schedule_shift_dir = 1;
-      }
-      else{
-        schedule_shift_dir = -1;
-      }
+    }
+  }
 
-      int pushed = schedule_task_push(schedule_working, task, schedule_shift_dir);
-      if (pushed == SUCCESS){
-        // recursion
-        schedule_solve_iter(task_memory, schedule_best, schedule_working);
+  // searched tasks never overlap anything else of the same user, but fixed tasks might overlap each other
+  // so a user is busy for at least all their searched tasks plus their longest fixed task
+  for (size_t t=0; t<task_memory->allocation_total; ++t){
+    Task* task = task_memory->tasks + t;
+    if ((task->trash == FALSE) && ((task->schedule_constraints & (SCHEDULE_CONSTRAINT_END | SCHEDULE_CONSTRAINT_START)) == 0)){
+      for (size_t u=0; u<task->user_qty; ++u){
+        task->users[u]->schedule_workload += task->day_duration;
       }
-      else{
-        schedule_task_pop(schedule_working);
+    }
+  }
+  schedule_working->bound_workload = 0;
+  for (size_t t=0; t<task_memory->allocation_total; ++t){
+    Task* task = task_memory->tasks + t;
+    if (task->trash == FALSE){
+      int64_t fixed_duration = 0;
+      if ((task->schedule_constraints & (SCHEDULE_CONSTRAINT_END | SCHEDULE_CONSTRAINT_START)) > 0){
+        fixed_duration = (int64_t) task->day_duration;
+      }
+      for (size_t u=0; u<task->user_qty; ++u){
+        int64_t workload = (int64_t) task->users[u]->schedule_workload + fixed_duration - 1;
+        if (workload > schedule_working->bound_workload){
+          schedule_working->bound_workload = workload;
+        }
       }
     }
-  } // end testing each possible alternate task
+  }
 
-  // TODO island detection....
+  free(order);
 }
 
 
-// scheduling algorithm built around having at least one fixed start/end task per task island
-int schedule_solve(Task_Memory* task_memory, Schedule_Event_List* schedule_best, Schedule_Event_List* schedule_working){
-  uint64_t cpu_timer_start = SDL_GetPerformanceCounter();
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// START WINDOWS
+// before searching, narrow down when each task can start. a forward pass over prereqs and no_sooner dates gives the
+// earliest start, a backward pass over dependents down from fixed dates gives the latest. a task whose window is
+// narrower than its duration is certain to be busy for part of it, and the other tasks of its users can't be then.
+// repeat until nothing moves. every schedule the solvers accept starts each task inside its window, so placements
+// outside of it are dead ends, and an empty window means there is no schedule at all
+
+#define SCHEDULE_WINDOW_ROUNDS 16
+
+// days a task keeps its users busy. the user busy index has zero duration tasks block their start day
+uint64_t schedule_window_length(Task* task){
+  if (task->day_duration == 0){
+    return 1;
+  }
+  return task->day_duration;
+}
 
-  Task* tasks = task_memory->tasks;
-  // reset previous search efforts
-  schedule_best->qty = 0;
-  schedule_working->qty = 0;
-  schedule_best->solved = FALSE;
-  schedule_working->solved = FALSE;
 
-  // clear out previous scheduling results
-  for (size_t t=0; t<task_memory->allocation_total; ++t){
-    tasks[t].schedule_done = FALSE;
+// push other tasks of the users of task out of the days task is certain to work. returns TRUE if any window moved
+int schedule_window_timetable(Task* task){
+  uint64_t part_start = task->schedule_latest_start;
+  uint64_t part_end = task->schedule_earliest_start + schedule_window_length(task) - 1;
+  int changed = FALSE;
+  for (size_t u=0; u<task->user_qty; ++u){
+    User* user = task->users[u];
+    for (size_t i=0; i<user->task_qty; ++i){
+      Task* other = user->tasks[i];
+      // fixed tasks may overlap each other
+      if ((other == task) || (other->trash == TRUE) || ((other->schedule_constraints & (SCHEDULE_CONSTRAINT_END | SCHEDULE_CONSTRAINT_START)) > 0)){
+        continue;
+      }
+      uint64_t length = schedule_window_length(other);
+      if ((other->schedule_earliest_start <= part_end) && (other->schedule_earliest_start + length - 1 >= part_start)){
+        other->schedule_earliest_start = part_end + 1;
+        changed = TRUE;
+      }
+      if ((other->schedule_latest_start != UINT64_MAX) && (other->schedule_latest_start <= part_end) && (other->schedule_latest_start + length - 1 >= part_start)){
+        if (part_start >= length){
+          other->schedule_latest_start = part_start - length;
+        }
+        else if (other->schedule_earliest_start <= part_end){
+          other->schedule_earliest_start = part_end + 1; // no room before, which empties the window
+        }
+        changed = TRUE;
+      }
+    }
   }
+  return changed;
+}
 
-  // pre-process some constraints
-  // TODO check for direct conflicts in these
-  for (size_t t=0; t<task_memory->allocation_total; ++t){
-    if ((tasks[t].schedule_constraints & (SCHEDULE_CONSTRAINT_END | SCHEDULE_CONSTRAINT_START)) > 0){
-      // schedule this fixed constraint task
-      printf("[SCHEDULER] task %s is a locked schedule task of type %lu\n", tasks[t].task_name, tasks[t].schedule_constraints);
-      tasks[t].schedule_done = TRUE;
-      schedule_working->events[schedule_working->qty].task = tasks + t;
 
-      if ((tasks[t].schedule_constraints & SCHEDULE_CONSTRAINT_END) > 0){
-        tasks[t].day_start = tasks[t].day_end - tasks[t].day_duration + 1;
+// fill in schedule_earliest_start and schedule_latest_start of every task. returns FAILURE if some task has no room
+// chains are measured like the final prereq check; a task may start on the day its prereq ends
+int schedule_windows_prepare(Task_Memory* task_memory){
+  Task* tasks = task_memory->tasks;
+  for (size_t t=0; t<task_memory->allocation_total; ++t){
+    Task* task = tasks + t;
+    task->schedule_earliest_start = 0;
+    task->schedule_latest_start = UINT64_MAX;
+    if ((task->schedule_constraints & SCHEDULE_CONSTRAINT_NOSOONER) > 0){
+      task->schedule_earliest_start = task->day_no_sooner;
+    }
+    if ((task->schedule_constraints & (SCHEDULE_CONSTRAINT_END | SCHEDULE_CONSTRAINT_START)) > 0){
+      uint64_t fixed = task->day_start;
+      if ((task->schedule_constraints & SCHEDULE_CONSTRAINT_END) > 0){
+        fixed = task->day_end - task->day_duration + 1;
       }
-      else if ((tasks[t].schedule_constraints & SCHEDULE_CONSTRAINT_START) > 0){
-        tasks[t].day_end = tasks[t].day_start + tasks[t].day_duration - 1;
+      if (task->schedule_earliest_start < fixed){
+        task->schedule_earliest_start = fixed;
       }
-      schedule_working->events[schedule_working->qty].date = tasks[t].day_start;
-      //printf("  schedule for %lu to %lu\n", tasks[t].day_start, tasks[t].day_end);
-
-      schedule_working->qty += 1;
+      task->schedule_latest_start = fixed;
     }
   }
 
-  printf("[SCHEDULER] after constraints, have %lu tasks to schedule\n", task_memory->allocation_used - schedule_working->qty);
-
-  // grow in all direction from fixed_start and fixed_end tasks? need to have dependent AND prereq data
-  schedule_solve_iter(task_memory, schedule_best, schedule_working);
+  // a prereq loop can never be scheduled, no sense in searching
+  Task** order = (Task**) malloc(task_memory->allocation_used * sizeof(Task*));
+  size_t order_qty = schedule_topological_order(task_memory, order);
+  if (order_qty < task_memory->allocation_used){
+    free(order);
+    printf("[SCHEDULER] prereqs loop, %lu tasks can't be put in order\n", task_memory->allocation_used - order_qty);
+    return FAILURE;
+  }
 
-  // TODO fail if impossible to satisfy prerequisite chain; if start date is earlier than a scheduled end date for task X
+  Task* empty = NULL;
+  for (size_t round=0; (round < SCHEDULE_WINDOW_ROUNDS) && (empty == NULL); ++round){
+    int changed = FALSE;
+
+    // forwards, no sooner than the prereqs can end
+    for (size_t i=0; i<order_qty; ++i){
+      Task* task = order[i];
+      for (size_t p=0; p<task->prereq_qty; ++p){
+        Task* prereq = task->prereqs[p];
+        if ((prereq->trash == FALSE) && (prereq->schedule_earliest_start + prereq->day_duration > task->schedule_earliest_start + 1)){
+          task->schedule_earliest_start = prereq->schedule_earliest_start + prereq->day_duration - 1;
+          changed = TRUE;
+        }
+      }
+    }
 
-  //printf("final best schedule: \n");
+    // backwards, ending no later than the dependents can start
+    for (size_t i=order_qty; i>0; i--){
+      Task* task = order[i-1];
+      for (size_t d=0; d<task->dependent_qty; ++d){
+        Task* dependent = task->dependents[d];
+        if ((dependent->trash == TRUE) || (dependent->schedule_latest_start == UINT64_MAX)){
+          continue;
+        }
+        if (dependent->schedule_latest_start + 1 < task->day_duration){
+          empty = task;
+        }
+        else if (dependent->schedule_latest_start + 1 - task->day_duration < task->schedule_latest_start){
+          task->schedule_latest_start = dependent->schedule_latest_start + 1 - task->day_duration;
+          changed = TRUE;
+        }
+      }
+    }
 
-  uint64_t cpu_timer_end = SDL_GetPerformanceCounter();
-  double cpu_timer_elapsed = ((double) cpu_timer_end - cpu_timer_start) / ((double) SDL_GetPerformanceFrequency());
-  schedule_best->solve_time_ms = cpu_timer_elapsed*1000;
+    // users are busy for the part of a tight window that every start in it covers
+    for (size_t i=0; i<order_qty; ++i){
+      Task* task = order[i];
+      if ((task->schedule_latest_start != UINT64_MAX) && (task->schedule_latest_start <= task->schedule_earliest_start + schedule_window_length(task) - 1)){
+        if (schedule_window_timetable(task) == TRUE){
+          changed = TRUE;
+        }
+      }
+    }
 
-  if (schedule_best->solved == TRUE){
-    for(size_t e=0; e<schedule_best->qty; ++e){
-      schedule_best->events[e].task->day_start = schedule_best->events[e].date;
-      schedule_best->events[e].task->day_end = schedule_best->events[e].task->day_start + schedule_best->events[e].task->day_duration - 1;
+    for (size_t i=0; i<order_qty; ++i){
+      if (order[i]->schedule_earliest_start > order[i]->schedule_latest_start){
+        empty = order[i];
+      }
+    }
+    if (changed == FALSE){
+      break;
     }
-    printf("[SCHEDULER] schedule solve done: SUCCESS. time: %.3lf ms\n", cpu_timer_elapsed*1000);
-    return SUCCESS;
+  }
+  free(order);
+
+  if (empty != NULL){
+    printf("[SCHEDULER] task %s has no room between its prereqs, dependents, users and dates\n", empty->task_name);
+    return FAILURE;
+  }
+  return SUCCESS;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// INCREMENTAL REPAIR
+// after an edit, only the tasks that changed, the later work of their users, and everything downstream get placed again
+// the rest of the last schedule stays where it was. the repair places tasks like the list scheduler does
+
+uint64_t schedule_hash_bytes(uint64_t hash, const void* data, size_t length){
+  const uint8_t* bytes = (const uint8_t*) data;
+  for (size_t i=0; i<length; ++i){
+    hash ^= bytes[i];
+    hash *= 1099511628211ULL; // FNV-1a
+  }
+  return hash;
+}
+
+
+// hash of everything the scheduler reads from a task. if it still matches, the task's old placement is still valid
+uint64_t schedule_task_signature(Task* task){
+  uint64_t hash = 14695981039346656037ULL;
+  hash = schedule_hash_bytes(hash, task->task_name, task->task_name_length);
+  hash = schedule_hash_bytes(hash, &task->day_duration, sizeof(task->day_duration));
+  hash = schedule_hash_bytes(hash, &task->schedule_constraints, sizeof(task->schedule_constraints));
+  if ((task->schedule_constraints & SCHEDULE_CONSTRAINT_START) > 0){
+    hash = schedule_hash_bytes(hash, &task->day_start, sizeof(task->day_start));
+  }
+  if ((task->schedule_constraints & SCHEDULE_CONSTRAINT_END) > 0){
+    hash = schedule_hash_bytes(hash, &task->day_end, sizeof(task->day_end));
+  }
+  if ((task->schedule_constraints & SCHEDULE_CONSTRAINT_NOSOONER) > 0){
+    hash = schedule_hash_bytes(hash, &task->day_no_sooner, sizeof(task->day_no_sooner));
+  }
+  // prereqs and users by name, not by address. a snapshot's copies must hash the same as the live model
+  for (size_t i=0; i<task->prereq_qty; ++i){
+    Task* prereq = task->prereqs[i];
+    if (prereq->trash == FALSE){
+      hash = schedule_hash_bytes(hash, &prereq->task_name_length, sizeof(prereq->task_name_length));
+      hash = schedule_hash_bytes(hash, prereq->task_name, prereq->task_name_length);
+    }
+  }
+  for (size_t i=0; i<task->user_qty; ++i){
+    User* user = task->users[i];
+    hash = schedule_hash_bytes(hash, &user->name_length, sizeof(user->name_length));
+    hash = schedule_hash_bytes(hash, user->name, user->name_length);
+  }
+  return hash;
+}
+
+
+// remember what the solved schedule was built from
+void schedule_signature_record(Task_Memory* task_memory){
+  for (size_t t=0; t<task_memory->allocation_total; ++t){
+    if (task_memory->tasks[t].trash == FALSE){
+      task_memory->tasks[t].schedule_signature = schedule_task_signature(task_memory->tasks + t);
+    }
+  }
+}
+
+
+// the days a fixed task must take, as schedule_task_fix() will put it. FALSE if the task isn't fixed
+int schedule_task_fixed_days(Task* task, uint64_t* start, uint64_t* end){
+  if ((task->schedule_constraints & SCHEDULE_CONSTRAINT_END) > 0){
+    *end = task->day_end;
+    *start = task->day_end - task->day_duration + 1;
+    return TRUE;
+  }
+  if ((task->schedule_constraints & SCHEDULE_CONSTRAINT_START) > 0){
+    *start = task->day_start;
+    *end = task->day_start + task->day_duration - 1;
+    return TRUE;
+  }
+  return FALSE;
+}
+
+
+// TRUE if a task that isn't fixed is on any of the days [start, end]. fixed tasks may overlap each other, see
+// schedule_window_timetable()
+int schedule_task_in_fixed_days(Task* other, uint64_t start, uint64_t end){
+  uint8_t fixed = ((other->schedule_constraints & (SCHEDULE_CONSTRAINT_END | SCHEDULE_CONSTRAINT_START)) > 0);
+  return ((other->trash == FALSE) && (fixed == FALSE) && (other->day_start <= end) && (start <= other->day_end));
+}
+
+
+// the first task that a user of this fixed one has on its days, NULL if none
+Task* schedule_task_fixed_overlap(Task* task){
+  uint64_t start;
+  uint64_t end;
+  if (schedule_task_fixed_days(task, &start, &end) == FALSE){
+    return NULL;
+  }
+  for (size_t u=0; u<task->user_qty; ++u){
+    User* user = task->users[u];
+    for (size_t t=0; t<user->task_qty; ++t){
+      if (schedule_task_in_fixed_days(user->tasks[t], start, end) == TRUE){
+        return user->tasks[t];
+      }
+    }
+  }
+  return NULL;
+}
+
+
+// mark the tasks that need placing again. returns how many
+size_t schedule_repair_region(Task_Memory* task_memory, Task** region){
+  size_t seed_qty = 0;
+  for (size_t t=0; t<task_memory->allocation_total; ++t){
+    Task* task = task_memory->tasks + t;
+    if ((task->trash == FALSE) && (task->schedule_dirty == TRUE)){
+      region[seed_qty] = task;
+      seed_qty += 1;
+    }
+  }
+  size_t region_qty = seed_qty;
+
+  // the users of a changed task may be able to shuffle everything they do after it
+  for (size_t s=0; s<seed_qty; ++s){
+    Task* seed = region[s];
+    for (size_t u=0; u<seed->user_qty; ++u){
+      User* user = seed->users[u];
+      for (size_t t=0; t<user->task_qty; ++t){
+        Task* other = user->tasks[t];
+        if ((other->trash == FALSE) && (other->schedule_dirty == FALSE)){
+          if ((seed->schedule_day_previous == UINT64_MAX) || (other->day_start >= seed->schedule_day_previous)){
+            other->schedule_dirty = TRUE;
+            region[region_qty] = other;
+            region_qty += 1;
+          }
+        }
+      }
+    }
+  }
+
+  // a fixed date may have moved onto a frozen task of its users, that one has to make way. and anything downstream may
+  // have to move
+  for (size_t r=0; r<region_qty; ++r){
+    Task* task = region[r];
+    uint64_t start;
+    uint64_t end;
+    if (schedule_task_fixed_days(task, &start, &end) == TRUE){
+      for (size_t u=0; u<task->user_qty; ++u){
+        User* user = task->users[u];
+        for (size_t t=0; t<user->task_qty; ++t){
+          Task* other = user->tasks[t];
+          if ((other->schedule_dirty == FALSE) && (schedule_task_in_fixed_days(other, start, end) == TRUE)){
+            other->schedule_dirty = TRUE;
+            region[region_qty] = other;
+            region_qty += 1;
+          }
+        }
+      }
+    }
+    for (size_t d=0; d<task->dependent_qty; ++d){
+      Task* dependent = task->dependents[d];
+      if (dependent->schedule_dirty == FALSE){
+        dependent->schedule_dirty = TRUE;
+        region[region_qty] = dependent;
+        region_qty += 1;
+      }
+    }
+  }
+  assert(region_qty <= task_memory->allocation_used);
+  return region_qty;
+}
+
+
+// take the region off the schedule, and nothing else. only the region's users get a fresh busy index, holding just
+// their frozen tasks. the rest of the tasks and users keep whatever the last solve left, the repair never reads them
+void schedule_repair_reset(Task** region, size_t region_qty){
+  for (size_t r=0; r<region_qty; ++r){
+    Task* task = region[r];
+    task->schedule_done = FALSE;
+    // a prereq outside the region is frozen, already placed
+    task->schedule_prereq_remaining = 0;
+    for (size_t i=0; i<task->prereq_qty; ++i){
+      if ((task->prereqs[i]->trash == FALSE) && (task->prereqs[i]->schedule_dirty == TRUE)){
+        task->schedule_prereq_remaining += 1;
+      }
+    }
+    task->schedule_dependent_remaining = task->dependent_qty;
+  }
+
+  for (size_t r=0; r<region_qty; ++r){
+    Task* task = region[r];
+    for (size_t u=0; u<task->user_qty; ++u){
+      User* user = task->users[u];
+      if (user->schedule_repair == TRUE){
+        continue;
+      }
+      user->schedule_repair = TRUE;
+      schedule_busy_clear(user);
+      for (size_t t=0; t<user->task_qty; ++t){
+        Task* other = user->tasks[t];
+        if ((other->trash == FALSE) && (other->schedule_dirty == FALSE)){
+          for (size_t i=0; i<other->user_qty; ++i){
+            if (other->users[i] == user){
+              schedule_busy_insert(user, other->schedule_busy_nodes + i, other);
+            }
+          }
+        }
+      }
+    }
+  }
+
+  for (size_t r=0; r<region_qty; ++r){
+    for (size_t u=0; u<region[r]->user_qty; ++u){
+      region[r]->users[u]->schedule_repair = FALSE;
+    }
+  }
+}
+
+
+// schedule_topological_order() of just the region, returns less than region_qty if its prereqs loop
+// a loop made by an edit is always inside the region, everything on it is downstream of the edit
+size_t schedule_repair_order(Task_Memory* task_memory, Task** region, size_t region_qty, Task** order){
+  size_t* prereqs_waiting = (size_t*) malloc(task_memory->allocation_total * sizeof(size_t)); // only region entries are used
+  size_t qty = 0;
+  for (size_t r=0; r<region_qty; ++r){
+    Task* task = region[r];
+    prereqs_waiting[task - task_memory->tasks] = task->schedule_prereq_remaining;
+    if (task->schedule_prereq_remaining == 0){
+      order[qty] = task;
+      ++qty;
+    }
+  }
+
+  for (size_t i=0; i<qty; ++i){
+    Task* task = order[i];
+    for (size_t d=0; d<task->dependent_qty; ++d){
+      if (task->dependents[d]->trash == TRUE){
+        continue;
+      }
+      size_t index = task->dependents[d] - task_memory->tasks;
+      prereqs_waiting[index] -= 1;
+      if (prereqs_waiting[index] == 0){
+        order[qty] = task->dependents[d];
+        ++qty;
+      }
+    }
+  }
+
+  free(prereqs_waiting);
+  return qty;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// SOLVE
+
+// schedule a fixed constraint task on its fixed dates
+void schedule_task_fix(Task_Memory* task_memory, Schedule_Event_List* schedule_working, Task* task){
+  if ((task->schedule_constraints & SCHEDULE_CONSTRAINT_END) > 0){
+    task->day_start = task->day_end - task->day_duration + 1;
+  }
+  else if ((task->schedule_constraints & SCHEDULE_CONSTRAINT_START) > 0){
+    task->day_end = task->day_start + task->day_duration - 1;
+  }
+  // the user busy index is keyed on day_start, so set the dates first
+  schedule_task_done_set(task_memory, task);
+  //printf("  schedule for %lu to %lu\n", task->day_start, task->day_end);
+
+  schedule_event_add(schedule_working, task);
+}
+
+
+// scheduling algorithm built around having at least one fixed start/end task per task island
+// clear out previous scheduling results, and put the fixed tasks in place
+void schedule_solve_prepare(Task_Memory* task_memory, Schedule_Event_List* schedule_working){
+  Task* tasks = task_memory->tasks;
+  schedule_working->qty = 0;
+  schedule_working->solved = FALSE;
+  schedule_ready_init(task_memory);
+
+  // pre-process some constraints
+  // TODO check for direct conflicts in these
+  for (size_t t=0; t<task_memory->allocation_total; ++t){
+    if ((tasks[t].trash == FALSE) && ((tasks[t].schedule_constraints & (SCHEDULE_CONSTRAINT_END | SCHEDULE_CONSTRAINT_START)) > 0)){
+      printf("[SCHEDULER] task %s is a locked schedule task of type %lu\n", tasks[t].task_name, tasks[t].schedule_constraints);
+      schedule_task_fix(task_memory, schedule_working, tasks + t);
+    }
+  }
+}
+
+
+// scheduling algorithm built around having at least one fixed start/end task per task island
+// with a time budget on schedule_working the search is anytime: it stops when time is up and keeps the best so far
+int schedule_solve(Task_Memory* task_memory, Schedule_Event_List* schedule_best, Schedule_Event_List* schedule_working, uint8_t solver){
+  uint64_t cpu_timer_start = SDL_GetPerformanceCounter();
+
+  // on one thread, a portfolio or a parallel DFS is a bounded DFS. see schedule_solve_portfolio() and schedule_solve_parallel()
+  uint8_t search = solver;
+  if ((solver == SCHEDULE_SOLVER_PORTFOLIO) || (solver == SCHEDULE_SOLVER_DFS_PARALLEL)){
+    search = SCHEDULE_SOLVER_DFS_BOUNDED;
+  }
+
+  // reset previous search efforts
+  schedule_best->qty = 0;
+  schedule_best->solved = FALSE;
+  schedule_best->solver = solver;
+  schedule_working->solver = search;
+  schedule_working->search_nodes = 0;
+  schedule_working->search_prunes = 0;
+  schedule_working->bound_workload = 0;
+  schedule_working->repaired_qty = 0;
+  memset(&schedule_working->stats, 0, sizeof(Schedule_Stats));
+  schedule_working->timer_start = cpu_timer_start;
+  schedule_working->improvements = 0;
+  schedule_working->timed_out = FALSE;
+  schedule_working->optimal = FALSE;
+  uint64_t lap = cpu_timer_start;
+
+  // lower bounds are needed as soon as the fixed tasks go into the event list
+  if (search == SCHEDULE_SOLVER_DFS_BOUNDED){
+    schedule_bounds_prepare(task_memory, schedule_working);
+  }
+
+  schedule_solve_prepare(task_memory, schedule_working);
+  printf("[SCHEDULER] after constraints, have %lu tasks to schedule\n", task_memory->allocation_used - schedule_working->qty);
+  schedule_stats_lap(&schedule_working->stats, SCHEDULE_PHASE_PREPARE, &lap);
+
+  // grow in all direction from fixed_start and fixed_end tasks? need to have dependent AND prereq data
+  int windows = schedule_windows_prepare(task_memory);
+  schedule_stats_lap(&schedule_working->stats, SCHEDULE_PHASE_WINDOWS, &lap);
+  if (windows == FAILURE){
+    printf("[SCHEDULER] no schedule fits the dates, not searching\n");
+    schedule_best->optimal = FALSE;
+  }
+  else if ((search == SCHEDULE_SOLVER_DFS) || (search == SCHEDULE_SOLVER_DFS_BOUNDED)){
+    if (schedule_working->time_budget_ms > 0){
+      // the search may not finish in time. a quick list schedule first means there's always something to show
+      schedule_solve_list(task_memory, schedule_best, schedule_working, SCHEDULE_SOLVER_LIST_PATH);
+      schedule_solve_prepare(task_memory, schedule_working);
+      schedule_stats_lap(&schedule_working->stats, SCHEDULE_PHASE_SEED, &lap);
+    }
+    schedule_solve_iter(task_memory, schedule_best, schedule_working);
+
+    uint8_t cancelled = ((schedule_working->cancel != NULL) && (SDL_AtomicGet(schedule_working->cancel) != 0));
+    schedule_best->optimal = ((schedule_best->solved == TRUE) && (schedule_working->timed_out == FALSE) && (cancelled == FALSE));
+  }
+  else{
+    schedule_solve_list(task_memory, schedule_best, schedule_working, solver);
+    schedule_best->optimal = FALSE; // a single pass heuristic, proves nothing
+  }
+  schedule_stats_lap(&schedule_working->stats, SCHEDULE_PHASE_SEARCH, &lap);
+
+  // TODO fail if impossible to satisfy prerequisite chain; if start date is earlier than a scheduled end date for task X
+
+  //printf("final best schedule: \n");
+
+  uint64_t cpu_timer_end = SDL_GetPerformanceCounter();
+  double cpu_timer_elapsed = ((double) cpu_timer_end - cpu_timer_start) / ((double) SDL_GetPerformanceFrequency());
+  schedule_best->solve_time_ms = cpu_timer_elapsed*1000;
+  schedule_best->search_nodes = schedule_working->search_nodes;
+  schedule_best->search_prunes = schedule_working->search_prunes;
+  schedule_best->repaired_qty = 0;
+  schedule_best->timed_out = schedule_working->timed_out;
+  schedule_best->improvements = schedule_working->improvements;
+  if (schedule_working->timed_out == TRUE){
+    printf("[SCHEDULER] time budget of %.0lf ms used up, keeping the best schedule so far\n", schedule_working->time_budget_ms);
+  }
+
+  if (schedule_best->solved == TRUE){
+    schedule_best_events(task_memory, schedule_best);
+    schedule_signature_record(task_memory);
+    schedule_stats_lap(&schedule_working->stats, SCHEDULE_PHASE_FINISH, &lap);
+  }
+  schedule_best->stats = schedule_working->stats;
+
+  if (schedule_best->solved == TRUE){
+    printf("[SCHEDULER] schedule solve (%s) done: SUCCESS. time: %.3lf ms, nodes: %lu, pruned: %lu\n", schedule_solver_name(solver), cpu_timer_elapsed*1000, schedule_best->search_nodes, schedule_best->search_prunes);
+    return SUCCESS;
+  }
+  else{
+    printf("[SCHEDULER] schedule solve (%s) done: FAILURE. time: %.3lf ms, nodes: %lu, pruned: %lu\n", schedule_solver_name(solver), cpu_timer_elapsed*1000, schedule_best->search_nodes, schedule_best->search_prunes);
+    return FAILURE;
+  }
+
+}
+
+
+// re-solve only what changed since schedule_best was solved. falls back to a full solve when there's nothing to keep
+// the repair is a list placement for every solver, so the result is never optimal. past the diff it costs the region
+int schedule_solve_incremental(Task_Memory* task_memory, Schedule_Event_List* schedule_best, Schedule_Event_List* schedule_working, uint8_t solver){
+  if ((schedule_best->solved == FALSE) || (schedule_best->solver != solver)){
+    return schedule_solve(task_memory, schedule_best, schedule_working, solver);
+  }
+  uint64_t cpu_timer_start = SDL_GetPerformanceCounter();
+
+  // diff against the last schedule. anything not found there unchanged is dirty
+  Task* tasks = task_memory->tasks;
+  for (size_t t=0; t<task_memory->allocation_total; ++t){
+    tasks[t].schedule_dirty = TRUE;
+    tasks[t].schedule_day_previous = UINT64_MAX;
+  }
+  size_t frozen_qty = 0;
+  for (size_t e=0; e<schedule_best->qty; ++e){
+    Task* task = schedule_best->events[e].task;
+    if (task->trash == FALSE){
+      task->schedule_day_previous = schedule_best->events[e].date;
+      if (task->schedule_signature == schedule_task_signature(task)){
+        task->schedule_dirty = FALSE;
+        task->day_start = schedule_best->events[e].date;
+        task->day_end = task->day_start + task->day_duration - 1;
+        frozen_qty += 1;
+      }
+    }
+  }
+  if (frozen_qty == 0){
+    return schedule_solve(task_memory, schedule_best, schedule_working, solver);
+  }
+
+  Task** region = (Task**) malloc(task_memory->allocation_used * sizeof(Task*));
+  size_t region_qty = schedule_repair_region(task_memory, region);
+  if (region_qty == task_memory->allocation_used){
+    free(region);
+    return schedule_solve(task_memory, schedule_best, schedule_working, solver);
+  }
+
+  schedule_working->qty = 0;
+  schedule_working->solved = FALSE;
+  schedule_working->solver = solver;
+  schedule_working->search_nodes = 0;
+  schedule_working->search_prunes = 0;
+  schedule_working->bound_workload = 0;
+  memset(&schedule_working->stats, 0, sizeof(Schedule_Stats));
+  schedule_working->timer_start = cpu_timer_start;
+  schedule_working->improvements = 0;
+  schedule_working->timed_out = FALSE;
+  schedule_working->optimal = FALSE;
+  uint64_t lap = cpu_timer_start;
+
+  // from here on only the region is touched. frozen tasks already sit on their old dates from the diff
+  schedule_repair_reset(region, region_qty);
+
+  // a task with no prereqs stays near where it was, the rest follow their prereqs
+  for (size_t r=0; r<region_qty; ++r){
+    Task* task = region[r];
+    task->schedule_earliest_start = 0;
+    if ((task->schedule_constraints & SCHEDULE_CONSTRAINT_NOSOONER) > 0){
+      task->schedule_earliest_start = task->day_no_sooner;
+    }
+    if ((task->schedule_constraints & (SCHEDULE_CONSTRAINT_END | SCHEDULE_CONSTRAINT_START)) > 0){
+      schedule_task_fix(task_memory, schedule_working, task);
+    }
+    else{
+      task->day_start = schedule_best->day_start;
+      if (task->schedule_day_previous != UINT64_MAX){
+        uint8_t has_prereq = FALSE;
+        for (size_t p=0; p<task->prereq_qty; ++p){
+          if (task->prereqs[p]->trash == FALSE){
+            has_prereq = TRUE;
+          }
+        }
+        if (has_prereq == FALSE){
+          task->day_start = task->schedule_day_previous;
+        }
+      }
+    }
+  }
+  schedule_stats_lap(&schedule_working->stats, SCHEDULE_PHASE_PREPARE, &lap);
+
+  // the list scheduler's pass over the region, whatever the solver. frozen prereqs are counted off already
+  Task** order = (Task**) malloc(region_qty * sizeof(Task*));
+  size_t order_qty = schedule_repair_order(task_memory, region, region_qty, order);
+  schedule_stats_lap(&schedule_working->stats, SCHEDULE_PHASE_WINDOWS, &lap);
+  if (order_qty == region_qty){
+    uint8_t priority = solver;
+    if ((solver != SCHEDULE_SOLVER_LIST_PATH) && (solver != SCHEDULE_SOLVER_LIST_FINISH)){
+      priority = SCHEDULE_SOLVER_LIST_PATH;
+    }
+    schedule_list_priorities(order, order_qty);
+    schedule_list_place(task_memory, schedule_working, order, order_qty, priority);
+    schedule_working->solved = schedule_list_validate(order, order_qty);
+  }
+  // the rest were fitted around the busy index, a fixed task was put down wherever its dates are
+  for (size_t r=0; (r < region_qty) && (schedule_working->solved == TRUE); ++r){
+    Task* other = schedule_task_fixed_overlap(region[r]);
+    if (other != NULL){
+      printf("[SCHEDULER] incremental repair: fixed task %s overlaps %s\n", region[r]->task_name, other->task_name);
+      schedule_working->solved = FALSE;
+    }
+  }
+  free(order);
+  schedule_stats_lap(&schedule_working->stats, SCHEDULE_PHASE_SEARCH, &lap);
+
+  if (schedule_working->solved == FALSE){
+    free(region);
+    printf("[SCHEDULER] incremental repair failed, solving from scratch\n");
+    return schedule_solve(task_memory, schedule_best, schedule_working, solver);
+  }
+
+  // patch the last schedule: frozen events stay as they are, the region's go on the end
+  uint64_t day_earliest = UINT64_MAX;
+  uint64_t day_latest = 0;
+  size_t kept = 0;
+  for (size_t e=0; e<schedule_best->qty; ++e){
+    Task* task = schedule_best->events[e].task;
+    if ((task->trash == FALSE) && (task->schedule_dirty == FALSE)){
+      schedule_best->events[kept] = schedule_best->events[e];
+      kept += 1;
+      if (task->day_start < day_earliest){
+        day_earliest = task->day_start;
+      }
+      if (task->day_end > day_latest){
+        day_latest = task->day_end;
+      }
+    }
+  }
+  schedule_best->qty = kept;
+  for (size_t r=0; r<region_qty; ++r){
+    Task* task = region[r];
+    schedule_event_add(schedule_best, task);
+    task->schedule_signature = schedule_task_signature(task);
+    if (task->day_start < day_earliest){
+      day_earliest = task->day_start;
+    }
+    if (task->day_end > day_latest){
+      day_latest = task->day_end;
+    }
+  }
+  free(region);
+
+  schedule_working->improvements = 1;
+  schedule_best->solved = TRUE;
+  schedule_best->day_start = day_earliest;
+  schedule_best->day_end = day_latest;
+  schedule_best->day_duration = day_latest - day_earliest;
+  schedule_best->solver = solver;
+  schedule_best->repaired_qty = region_qty;
+  schedule_best->improvements = 1;
+  schedule_best->timed_out = FALSE;
+  schedule_best->optimal = FALSE; // a single pass heuristic, proves nothing
+  schedule_stats_lap(&schedule_working->stats, SCHEDULE_PHASE_FINISH, &lap);
+  schedule_best->stats = schedule_working->stats;
+
+  uint64_t cpu_timer_end = SDL_GetPerformanceCounter();
+  double cpu_timer_elapsed = ((double) cpu_timer_end - cpu_timer_start) / ((double) SDL_GetPerformanceFrequency());
+  schedule_best->solve_time_ms = cpu_timer_elapsed*1000;
+  schedule_best->search_nodes = 0;
+  schedule_best->search_prunes = 0;
+  printf("[SCHEDULER] incremental solve (%s) done: SUCCESS. repaired %lu of %lu tasks, time: %.3lf ms\n", schedule_solver_name(solver), region_qty, task_memory->allocation_used, cpu_timer_elapsed*1000);
+  return SUCCESS;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// ISLANDS
+// tasks that share no prereq chain and no user can't affect each other. each island gets its own search
+// on a pool of threads, so the search space is the sum of the islands instead of their product
+// each island is kept as short as it can be on its own, and the ones without fixed dates are lined up with the rest.
+// that is only the shortest project if the merged schedule is no longer than the longest island, or than the fixed
+// dates span. otherwise the whole project is searched after all, if there's a time limit to search it in
+
+#define SCHEDULE_ISLAND_WATCH_MS 20 // how often a watched island or portfolio solve looks for better schedules to hand on
+
+typedef struct Schedule_Island{
+  Task_Memory task_memory; // the island's tasks, packed
+  User* users;
+  size_t user_qty;
+  Task** origin; // live task behind each packed task
+  Schedule_Event_List* best;
+  Schedule_Event_List* working;
+  Schedule_Event_List* progress; // better schedules of this island, under the pool's lock. NULL if nobody watches
+  uint64_t progress_merged; // improvements already merged
+  int status;
+} Schedule_Island;
+
+typedef struct Schedule_Island_Pool{
+  Schedule_Island* islands;
+  size_t qty;
+  SDL_atomic_t next; // next island to hand out
+  uint8_t solver;
+
+  // only when watched: the solving thread sleeps on finished, and merges the islands' progress in between
+  SDL_mutex* lock;
+  SDL_cond* finished;
+  size_t finished_qty;
+} Schedule_Island_Pool;
+
+
+size_t schedule_island_find(size_t* parent, size_t t){
+  while (parent[t] != t){
+    parent[t] = parent[parent[t]]; // path halving
+    t = parent[t];
+  }
+  return t;
+}
+
+
+void schedule_island_union(size_t* parent, size_t a, size_t b){
+  a = schedule_island_find(parent, a);
+  b = schedule_island_find(parent, b);
+  if (a < b){
+    parent[b] = a;
+  }
+  else if (b < a){
+    parent[a] = b;
+  }
+}
+
+
+// label every live task with its island, 0 to qty-1. returns the number of islands
+size_t schedule_island_label(Task_Memory* task_memory, size_t* island){
+  Task* tasks = task_memory->tasks;
+  size_t* parent = (size_t*) malloc(task_memory->allocation_total * sizeof(size_t));
+  for (size_t t=0; t<task_memory->allocation_total; ++t){
+    parent[t] = t;
+  }
+  for (size_t t=0; t<task_memory->allocation_total; ++t){
+    Task* task = tasks + t;
+    if (task->trash == FALSE){
+      for (size_t i=0; i<task->prereq_qty; ++i){
+        if (task->prereqs[i]->trash == FALSE){
+          schedule_island_union(parent, t, task->prereqs[i] - tasks);
+        }
+      }
+      // everything a user works on is one island, joining to this task is enough
+      for (size_t u=0; u<task->user_qty; ++u){
+        User* user = task->users[u];
+        for (size_t i=0; i<user->task_qty; ++i){
+          if (user->tasks[i]->trash == FALSE){
+            schedule_island_union(parent, t, user->tasks[i] - tasks);
+          }
+        }
+      }
+    }
+  }
+
+  size_t island_qty = 0;
+  for (size_t t=0; t<task_memory->allocation_total; ++t){
+    island[t] = SIZE_MAX;
+    if (tasks[t].trash == FALSE){
+      size_t root = schedule_island_find(parent, t);
+      if (root == t){
+        island[t] = island_qty;
+        island_qty += 1;
+      }
+      else{
+        island[t] = island[root]; // roots are always the lowest index, so already labelled
+      }
+    }
+  }
+  free(parent);
+  return island_qty;
+}
+
+
+// pack each island's tasks and users into their own memory, pointing at each other
+// tasks are packed in the order given, which is the order the DFS tries them in. NULL keeps memory order
+Schedule_Island* schedule_island_split(Task_Memory* task_memory, size_t* island, size_t island_qty, Task** order, Schedule_Event_List* schedule_working){
+  Task* tasks = task_memory->tasks;
+  Schedule_Island* islands = (Schedule_Island*) malloc(island_qty * sizeof(Schedule_Island));
+  memset(islands, 0, island_qty * sizeof(Schedule_Island));
+
+  // count tasks and users per island. a user marks itself as counted until it gets a real copy
+  size_t* packed = (size_t*) malloc(task_memory->allocation_total * sizeof(size_t));
+  for (size_t t=0; t<task_memory->allocation_total; ++t){
+    if (tasks[t].trash == FALSE){
+      for (size_t u=0; u<tasks[t].user_qty; ++u){
+        tasks[t].users[u]->schedule_island_copy = NULL;
+      }
+    }
+  }
+  size_t order_qty = task_memory->allocation_total;
+  if (order != NULL){
+    order_qty = task_memory->allocation_used;
+  }
+  for (size_t o=0; o<order_qty; ++o){
+    size_t t = o;
+    if (order != NULL){
+      t = order[o] - tasks;
+    }
+    if (tasks[t].trash == FALSE){
+      packed[t] = islands[island[t]].task_memory.allocation_total;
+      islands[island[t]].task_memory.allocation_total += 1;
+      for (size_t u=0; u<tasks[t].user_qty; ++u){
+        User* user = tasks[t].users[u];
+        if (user->schedule_island_copy == NULL){
+          user->schedule_island_copy = user;
+          islands[island[t]].user_qty += 1;
+        }
+      }
+    }
+  }
+  for (size_t t=0; t<task_memory->allocation_total; ++t){
+    if (tasks[t].trash == FALSE){
+      for (size_t u=0; u<tasks[t].user_qty; ++u){
+        tasks[t].users[u]->schedule_island_copy = NULL;
+      }
+    }
+  }
+
+  for (size_t i=0; i<island_qty; ++i){
+    Schedule_Island* isle = islands + i;
+    Task_Memory* tm = &isle->task_memory;
+    tm->allocation_used = tm->allocation_total;
+    tm->tasks = (Task*) malloc(tm->allocation_total * sizeof(Task));
+    tm->schedule_ready = (uint64_t*) malloc(schedule_ready_words(tm->allocation_total) * sizeof(uint64_t));
+    tm->schedule_pending = (uint64_t*) malloc(schedule_ready_words(tm->allocation_total) * sizeof(uint64_t));
+    isle->origin = (Task**) malloc(tm->allocation_total * sizeof(Task*));
+    isle->users = (User*) malloc(isle->user_qty * sizeof(User));
+    isle->user_qty = 0; // counts back up as they're copied
+    isle->best = schedule_create();
+    isle->working = schedule_create();
+    isle->working->time_budget_ms = schedule_working->time_budget_ms;
+    isle->working->cancel = schedule_working->cancel;
+  }
+
+  for (size_t t=0; t<task_memory->allocation_total; ++t){
+    if (tasks[t].trash == TRUE){
+      continue;
+    }
+    Schedule_Island* isle = islands + island[t];
+    Task* task = isle->task_memory.tasks + packed[t];
+    memcpy(task, tasks + t, sizeof(Task));
+    isle->origin[packed[t]] = tasks + t;
+
+    // links to deleted tasks don't survive the trip
+    task->prereq_qty = 0;
+    for (size_t i=0; i<tasks[t].prereq_qty; ++i){
+      if (tasks[t].prereqs[i]->trash == FALSE){
+        task->prereqs[task->prereq_qty] = isle->task_memory.tasks + packed[tasks[t].prereqs[i] - tasks];
+        task->prereq_qty += 1;
+      }
+    }
+    task->dependent_qty = 0;
+    for (size_t i=0; i<tasks[t].dependent_qty; ++i){
+      if (tasks[t].dependents[i]->trash == FALSE){
+        task->dependents[task->dependent_qty] = isle->task_memory.tasks + packed[tasks[t].dependents[i] - tasks];
+        task->dependent_qty += 1;
+      }
+    }
+    task->dependents_display_qty = 0;
+
+    for (size_t u=0; u<task->user_qty; ++u){
+      User* user = task->users[u];
+      if (user->schedule_island_copy == NULL){
+        User* copy = isle->users + isle->user_qty;
+        isle->user_qty += 1;
+        memcpy(copy, user, sizeof(User));
+        copy->task_qty = 0;
+        for (size_t i=0; i<user->task_qty; ++i){
+          if (user->tasks[i]->trash == FALSE){
+            copy->tasks[copy->task_qty] = isle->task_memory.tasks + packed[user->tasks[i] - tasks];
+            copy->task_qty += 1;
+          }
+        }
+        user->schedule_island_copy = copy;
+      }
+      task->users[u] = user->schedule_island_copy;
+    }
+  }
+
+  free(packed);
+  return islands;
+}
+
+
+void schedule_island_free(Schedule_Island* islands, size_t island_qty){
+  for (size_t i=0; i<island_qty; ++i){
+    free(islands[i].task_memory.tasks);
+    free(islands[i].task_memory.schedule_ready);
+    free(islands[i].task_memory.schedule_pending);
+    free(islands[i].origin);
+    free(islands[i].users);
+    schedule_free(islands[i].best);
+    schedule_free(islands[i].working);
+    if (islands[i].progress != NULL){
+      schedule_free(islands[i].progress);
+    }
+  }
+  free(islands);
+}
+
+
+// copy the island's schedule back onto the live tasks it came from, and into schedule_best
+void schedule_island_merge(Schedule_Island* isle, Schedule_Event_List* schedule_best){
+  for (size_t e=0; e<isle->best->qty; ++e){
+    Task* task = isle->origin[isle->best->events[e].task - isle->task_memory.tasks];
+    task->day_start = isle->best->events[e].date;
+    task->day_end = task->day_start + task->day_duration - 1;
+    schedule_event_add(schedule_best, task);
+  }
+}
+
+
+int schedule_island_run(void* data){
+  Schedule_Island_Pool* pool = (Schedule_Island_Pool*) data;
+  size_t i = (size_t) SDL_AtomicAdd(&pool->next, 1);
+  while (i < pool->qty){
+    Schedule_Island* isle = pool->islands + i;
+    isle->status = schedule_solve(&isle->task_memory, isle->best, isle->working, pool->solver);
+    if (pool->lock != NULL){
+      SDL_LockMutex(pool->lock);
+      pool->finished_qty += 1;
+      SDL_CondSignal(pool->finished);
+      SDL_UnlockMutex(pool->lock);
+    }
+    i = (size_t) SDL_AtomicAdd(&pool->next, 1);
+  }
+  return 0;
+}
+
+
+// with the pool's lock held. once every island has a schedule, each better one is merged with the rest and handed
+// to whoever watches schedule_working, pointing at its tasks
+void schedule_island_progress(Schedule_Island_Pool* pool, Schedule_Event_List* schedule_working){
+  uint8_t improved = FALSE;
+  for (size_t i=0; i<pool->qty; ++i){
+    Schedule_Island* isle = pool->islands + i;
+    if (isle->progress->improvements == 0){
+      return;
+    }
+    if (isle->progress->improvements > isle->progress_merged){
+      improved = TRUE;
+    }
+  }
+  if (improved == FALSE){
+    return;
+  }
+
+  SDL_LockMutex(schedule_working->progress_lock);
+  Schedule_Event_List* progress = schedule_working->progress;
+  uint64_t day_earliest = UINT64_MAX;
+  uint64_t day_latest = 0;
+  progress->qty = 0;
+  for (size_t i=0; i<pool->qty; ++i){
+    Schedule_Island* isle = pool->islands + i;
+    isle->progress_merged = isle->progress->improvements;
+    for (size_t e=0; e<isle->progress->qty; ++e){
+      Task* task = isle->origin[isle->progress->events[e].task - isle->task_memory.tasks];
+      progress->qty += 1;
+      schedule_memory_management(progress);
+      Schedule_Event* event = progress->events + progress->qty - 1;
+      *event = isle->progress->events[e];
+      event->task = task;
+      if (event->date < day_earliest){
+        day_earliest = event->date;
+      }
+      if (event->date + task->day_duration - 1 > day_latest){
+        day_latest = event->date + task->day_duration - 1;
+      }
+    }
+  }
+  progress->solved = TRUE;
+  progress->solver = pool->solver;
+  progress->day_start = day_earliest;
+  progress->day_end = day_latest;
+  progress->day_duration = day_latest - day_earliest;
+  progress->solve_time_ms = schedule_elapsed_ms(schedule_working);
+  progress->improvements += 1;
+  SDL_UnlockMutex(schedule_working->progress_lock);
+}
+
+
+// an island with no fixed dates can go on any day its no_sooner dates allow. each is solved on whatever day its own
+// search liked, so line them up: with the fixed islands if there are any, otherwise with the one that starts last.
+// later is always allowed, earlier only as far as the no_sooner dates let it
+void schedule_island_align(Schedule_Island* islands, size_t island_qty){
+  uint8_t* fixed = (uint8_t*) calloc(island_qty, sizeof(uint8_t));
+  uint64_t fixed_start = UINT64_MAX;
+  uint64_t free_start = 0;
+  for (size_t i=0; i<island_qty; ++i){
+    Schedule_Island* isle = islands + i;
+    for (size_t t=0; t<isle->task_memory.allocation_total; ++t){
+      if ((isle->task_memory.tasks[t].schedule_constraints & (SCHEDULE_CONSTRAINT_END | SCHEDULE_CONSTRAINT_START)) > 0){
+        fixed[i] = TRUE;
+      }
+    }
+    if (isle->status != SUCCESS){
+      continue;
+    }
+    if ((fixed[i] == TRUE) && (isle->best->day_start < fixed_start)){
+      fixed_start = isle->best->day_start;
+    }
+    if ((fixed[i] == FALSE) && (isle->best->day_start > free_start)){
+      free_start = isle->best->day_start;
+    }
+  }
+  uint64_t start = (fixed_start != UINT64_MAX) ? fixed_start : free_start;
+
+  for (size_t i=0; i<island_qty; ++i){
+    Schedule_Island* isle = islands + i;
+    if ((fixed[i] == TRUE) || (isle->status != SUCCESS) || (isle->best->day_start == start)){
+      continue;
+    }
+    int64_t shift = (int64_t) start - (int64_t) isle->best->day_start;
+    for (size_t e=0; e<isle->best->qty; ++e){
+      Task* task = isle->best->events[e].task;
+      if (((task->schedule_constraints & SCHEDULE_CONSTRAINT_NOSOONER) > 0) && ((int64_t) task->day_no_sooner - (int64_t) isle->best->events[e].date > shift)){
+        shift = (int64_t) task->day_no_sooner - (int64_t) isle->best->events[e].date;
+      }
+    }
+    for (size_t e=0; e<isle->best->qty; ++e){
+      isle->best->events[e].date += shift;
+    }
+    isle->best->day_start += shift;
+    isle->best->day_end += shift;
+  }
+  free(fixed);
+}
+
+
+// no schedule of the whole project is shorter than its longest island, or than the span of its fixed dates
+uint64_t schedule_island_bound(Task_Memory* task_memory, uint64_t island_longest){
+  uint64_t fixed_first = UINT64_MAX;
+  uint64_t fixed_last = 0;
+  for (size_t t=0; t<task_memory->allocation_total; ++t){
+    Task* task = task_memory->tasks + t;
+    if ((task->trash == FALSE) && ((task->schedule_constraints & (SCHEDULE_CONSTRAINT_END | SCHEDULE_CONSTRAINT_START)) > 0)){
+      if (task->day_start < fixed_first){
+        fixed_first = task->day_start;
+      }
+      if (task->day_end > fixed_last){
+        fixed_last = task->day_end;
+      }
+    }
+  }
+  if ((fixed_first != UINT64_MAX) && (fixed_last > fixed_first) && (fixed_last - fixed_first > island_longest)){
+    return fixed_last - fixed_first;
+  }
+  return island_longest;
+}
+
+
+// the islands came out longer together than the bound. search the whole project in the time that's left, and keep
+// the merged schedule if that does no better. with no time limit that search is the product of the islands, which is
+// what splitting them up was for, so then the merged schedule is kept as it is
+int schedule_island_fallback(Task_Memory* task_memory, Schedule_Event_List* schedule_best, Schedule_Event_List* schedule_working, uint8_t solver, uint64_t cpu_timer_start){
+  double time_budget_ms = schedule_working->time_budget_ms;
+  double elapsed_ms = ((double) SDL_GetPerformanceCounter() - cpu_timer_start) * 1000 / ((double) SDL_GetPerformanceFrequency());
+  schedule_best->optimal = FALSE;
+  if ((time_budget_ms <= 0) || (elapsed_ms >= time_budget_ms)){
+    schedule_best->timed_out = (time_budget_ms > 0);
+    printf("[SCHEDULER] island solve (%s) done: SUCCESS, not proven shortest. time: %.3lf ms\n", schedule_solver_name(solver), elapsed_ms);
+    return SUCCESS;
+  }
+  printf("[SCHEDULER] islands merged to %lu days, longer than any island or the fixed dates, searching the whole project\n", schedule_best->day_duration);
+
+  Schedule_Event_List* merged = schedule_create();
+  schedule_copy(merged, schedule_best);
+
+  // the merged schedule is already out there, the whole search's first tries would only be worse
+  Schedule_Event_List* progress = schedule_working->progress;
+  schedule_working->progress = NULL;
+  schedule_working->time_budget_ms = time_budget_ms - elapsed_ms;
+  int status = schedule_solve(task_memory, schedule_best, schedule_working, solver);
+  schedule_working->time_budget_ms = time_budget_ms;
+  schedule_working->progress = progress;
+
+  if ((status == FAILURE) || (schedule_best->day_duration > merged->day_duration)){
+    uint8_t timed_out = schedule_best->timed_out;
+    uint64_t search_nodes = schedule_best->search_nodes;
+    uint64_t search_prunes = schedule_best->search_prunes;
+    schedule_copy(schedule_best, merged);
+    for (size_t e=0; e<schedule_best->qty; ++e){
+      Task* task = schedule_best->events[e].task;
+      task->day_start = schedule_best->events[e].date;
+      task->day_end = task->day_start + task->day_duration - 1;
+    }
+    schedule_signature_record(task_memory);
+    schedule_best->optimal = FALSE;
+    schedule_best->timed_out = timed_out;
+    schedule_best->search_nodes = search_nodes;
+    schedule_best->search_prunes = search_prunes;
+    status = SUCCESS;
+  }
+  schedule_best->search_nodes += merged->search_nodes;
+  schedule_best->search_prunes += merged->search_prunes;
+  schedule_best->solve_time_ms = ((double) SDL_GetPerformanceCounter() - cpu_timer_start) * 1000 / ((double) SDL_GetPerformanceFrequency());
+  schedule_free(merged);
+  return status;
+}
+
+
+// solve each island on its own, in parallel, then merge them back into one schedule
+// a project that is all one island is solved as usual, and so is everything for the list solvers, which don't search
+int schedule_solve_islands(Task_Memory* task_memory, Schedule_Event_List* schedule_best, Schedule_Event_List* schedule_working, uint8_t solver){
+  if ((solver != SCHEDULE_SOLVER_DFS) && (solver != SCHEDULE_SOLVER_DFS_BOUNDED)){
+    return schedule_solve(task_memory, schedule_best, schedule_working, solver);
+  }
+  uint64_t cpu_timer_start = SDL_GetPerformanceCounter();
+  size_t* island = (size_t*) malloc(task_memory->allocation_total * sizeof(size_t));
+  size_t island_qty = schedule_island_label(task_memory, island);
+  if (island_qty < 2){
+    free(island);
+    return schedule_solve(task_memory, schedule_best, schedule_working, solver);
+  }
+
+  Schedule_Island_Pool pool;
+  pool.islands = schedule_island_split(task_memory, island, island_qty, NULL, schedule_working);
+  pool.qty = island_qty;
+  pool.solver = solver;
+  SDL_AtomicSet(&pool.next, 0);
+  pool.lock = NULL;
+  pool.finished = NULL;
+  pool.finished_qty = 0;
+  free(island);
+
+  // someone wants every better schedule as it's found. this thread merges the islands' for them instead of searching
+  uint8_t watched = (schedule_working->progress != NULL);
+  size_t thread_first = 1;
+  schedule_working->timer_start = cpu_timer_start;
+  if (watched == TRUE){
+    pool.lock = SDL_CreateMutex();
+    pool.finished = SDL_CreateCond();
+    thread_first = 0;
+    for (size_t i=0; i<island_qty; ++i){
+      pool.islands[i].progress = schedule_create();
+      pool.islands[i].working->progress = pool.islands[i].progress;
+      pool.islands[i].working->progress_lock = pool.lock;
+    }
+  }
+
+  size_t thread_qty = SDL_GetCPUCount();
+  if (thread_qty > island_qty){
+    thread_qty = island_qty;
+  }
+  printf("[SCHEDULER] solving %lu islands on %lu threads\n", island_qty, thread_qty);
+  SDL_Thread** threads = (SDL_Thread**) malloc(thread_qty * sizeof(SDL_Thread*));
+  for (size_t i=thread_first; i<thread_qty; ++i){
+    threads[i] = SDL_CreateThread(schedule_island_run, "schedule_island", (void*) &pool);
+  }
+  if (watched == FALSE){
+    schedule_island_run((void*) &pool); // this thread works too
   }
   else{
-    printf("[SCHEDULER] schedule solve done: FAILURE. time: %.3lf ms\n", cpu_timer_elapsed*1000);
+    SDL_LockMutex(pool.lock);
+    while (pool.finished_qty < island_qty){
+      SDL_CondWaitTimeout(pool.finished, pool.lock, SCHEDULE_ISLAND_WATCH_MS);
+      schedule_island_progress(&pool, schedule_working);
+    }
+    SDL_UnlockMutex(pool.lock);
+  }
+  for (size_t i=thread_first; i<thread_qty; ++i){
+    SDL_WaitThread(threads[i], NULL);
+  }
+  free(threads);
+  if (watched == TRUE){
+    SDL_DestroyCond(pool.finished);
+    SDL_DestroyMutex(pool.lock);
+  }
+
+  // merge. every island has to work for the project to work
+  schedule_island_align(pool.islands, island_qty);
+  schedule_best->qty = 0;
+  schedule_best->solved = TRUE;
+  schedule_best->solver = solver;
+  schedule_best->search_nodes = 0;
+  schedule_best->search_prunes = 0;
+  schedule_best->repaired_qty = 0;
+  memset(&schedule_best->stats, 0, sizeof(Schedule_Stats));
+  schedule_best->improvements = 0;
+  schedule_best->timed_out = FALSE;
+  schedule_best->optimal = TRUE;
+  uint64_t island_longest = 0;
+  for (size_t i=0; i<island_qty; ++i){
+    Schedule_Island* isle = pool.islands + i;
+    schedule_best->search_nodes += isle->best->search_nodes;
+    schedule_best->search_prunes += isle->best->search_prunes;
+    schedule_stats_add(&schedule_best->stats, &isle->best->stats);
+    if (isle->best->timed_out == TRUE){
+      schedule_best->timed_out = TRUE;
+    }
+    if (isle->best->optimal == FALSE){
+      schedule_best->optimal = FALSE;
+    }
+    if (isle->status != SUCCESS){
+      schedule_best->solved = FALSE;
+      continue;
+    }
+    if (isle->best->day_duration > island_longest){
+      island_longest = isle->best->day_duration;
+    }
+    schedule_island_merge(isle, schedule_best);
+  }
+  schedule_island_free(pool.islands, island_qty);
+
+  uint64_t cpu_timer_end = SDL_GetPerformanceCounter();
+  double cpu_timer_elapsed = ((double) cpu_timer_end - cpu_timer_start) / ((double) SDL_GetPerformanceFrequency());
+  schedule_best->solve_time_ms = cpu_timer_elapsed*1000;
+
+  if (schedule_best->solved == FALSE){
+    schedule_best->qty = 0;
+    schedule_best->optimal = FALSE;
+    printf("[SCHEDULER] island solve (%s) done: FAILURE. time: %.3lf ms\n", schedule_solver_name(solver), cpu_timer_elapsed*1000);
+    return FAILURE;
+  }
+  schedule_calculate_duration(schedule_best, task_memory);
+  schedule_signature_record(task_memory);
+  if ((schedule_best->optimal == TRUE) && (schedule_best->day_duration > schedule_island_bound(task_memory, island_longest))){
+    return schedule_island_fallback(task_memory, schedule_best, schedule_working, solver, cpu_timer_start);
+  }
+  printf("[SCHEDULER] island solve (%s) done: SUCCESS. time: %.3lf ms, nodes: %lu, pruned: %lu\n", schedule_solver_name(solver), cpu_timer_elapsed*1000, schedule_best->search_nodes, schedule_best->search_prunes);
+  return SUCCESS;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// PORTFOLIO
+// the bounded DFS is quick or slow depending on the order it tries tasks in, and there's no telling which order is
+// good ahead of time. so race one search per core, each on its own packed copy of the project in a different order.
+// they share the best duration found so far, so a good schedule from any of them prunes all of them.
+// the first to finish its search has proved the shared best optimal and stops the rest
+
+#define SCHEDULE_PORTFOLIO_MAX 16
+
+typedef struct Schedule_Portfolio{
+  Schedule_Island* instances[SCHEDULE_PORTFOLIO_MAX]; // a copy of the whole project each
+  uint8_t finished_search[SCHEDULE_PORTFOLIO_MAX]; // the instance's search ran to the end, not stopped early
+  size_t qty;
+  SDL_atomic_t next; // next instance to hand out
+  SDL_atomic_t incumbent; // best duration so far across every instance
+  SDL_atomic_t stop; // cancels every instance
+
+  // the solving thread sleeps on done, and hands on better schedules in between. the instances' progress is under lock
+  SDL_mutex* lock;
+  SDL_cond* done;
+  size_t finished_qty; // instances done, for whatever reason
+  uint64_t published; // duration of the last schedule handed on, UINT64_MAX before the first
+} Schedule_Portfolio;
+
+
+// fill order[] with every live task in the order instance k should try them
+void schedule_portfolio_order(Task_Memory* task_memory, Task** order, size_t k){
+  size_t qty = 0;
+  for (size_t t=0; t<task_memory->allocation_total; ++t){
+    if (task_memory->tasks[t].trash == FALSE){
+      order[qty] = task_memory->tasks + t;
+      qty += 1;
+    }
+  }
+
+  if ((k == 1) || (k == 2)){
+    // the list scheduler priorities, schedule_list_prepare() has filled them in
+    Schedule_Heap heap;
+    heap.tasks = (Task**) malloc(qty * sizeof(Task*));
+    heap.qty = 0;
+    heap.solver = SCHEDULE_SOLVER_LIST_PATH;
+    if (k == 2){
+      heap.solver = SCHEDULE_SOLVER_LIST_FINISH;
+    }
+    for (size_t i=0; i<qty; ++i){
+      schedule_heap_push(&heap, order[i]);
+    }
+    for (size_t i=0; i<qty; ++i){
+      order[i] = schedule_heap_pop(&heap);
+    }
+    free(heap.tasks);
+  }
+  else if (k == 3){
+    for (size_t i=0; i<qty/2; ++i){
+      Task* swap = order[i];
+      order[i] = order[qty-1 - i];
+      order[qty-1 - i] = swap;
+    }
+  }
+  else if (k > 3){
+    // shuffle, seeded by k so every run tries the same orders
+    uint64_t seed = 0x9E3779B97F4A7C15 * k;
+    for (size_t i=qty; i>1; i--){
+      seed ^= seed << 13;
+      seed ^= seed >> 7;
+      seed ^= seed << 17;
+      size_t j = seed % i;
+      Task* swap = order[i-1];
+      order[i-1] = order[j];
+      order[j] = swap;
+    }
+  }
+}
+
+
+int schedule_portfolio_run(void* data){
+  Schedule_Portfolio* portfolio = (Schedule_Portfolio*) data;
+  size_t i = (size_t) SDL_AtomicAdd(&portfolio->next, 1);
+  Schedule_Island* instance = portfolio->instances[i];
+  instance->status = schedule_solve(&instance->task_memory, instance->best, instance->working, SCHEDULE_SOLVER_PORTFOLIO);
+
+  // if the search wasn't stopped, nothing shorter than the shared best exists, no sense in the others carrying on
+  if ((instance->working->timed_out == FALSE) && (SDL_AtomicGet(&portfolio->stop) == 0)){
+    portfolio->finished_search[i] = TRUE;
+    SDL_AtomicSet(&portfolio->stop, 1);
+  }
+  SDL_LockMutex(portfolio->lock);
+  portfolio->finished_qty += 1;
+  SDL_CondSignal(portfolio->done);
+  SDL_UnlockMutex(portfolio->lock);
+  return 0;
+}
+
+
+// with the portfolio's lock held. if some instance has found a schedule shorter than the last one handed on, hand it
+// to whoever watches schedule_working, pointing at its tasks
+void schedule_portfolio_progress(Schedule_Portfolio* portfolio, Schedule_Event_List* schedule_working){
+  Schedule_Island* leader = NULL;
+  for (size_t k=0; k<portfolio->qty; ++k){
+    Schedule_Event_List* progress = portfolio->instances[k]->progress;
+    if ((progress->improvements > 0) && (progress->day_duration < portfolio->published)){
+      if ((leader == NULL) || (progress->day_duration < leader->progress->day_duration)){
+        leader = portfolio->instances[k];
+      }
+    }
+  }
+  if (leader == NULL){
+    return;
+  }
+  portfolio->published = leader->progress->day_duration;
+
+  SDL_LockMutex(schedule_working->progress_lock);
+  Schedule_Event_List* progress = schedule_working->progress;
+  uint64_t improvements = progress->improvements;
+  schedule_copy(progress, leader->progress);
+  for (size_t e=0; e<progress->qty; ++e){
+    progress->events[e].task = leader->origin[progress->events[e].task - leader->task_memory.tasks];
+  }
+  progress->solver = SCHEDULE_SOLVER_PORTFOLIO;
+  progress->solve_time_ms = schedule_elapsed_ms(schedule_working);
+  progress->improvements = improvements + 1;
+  SDL_UnlockMutex(schedule_working->progress_lock);
+}
+
+
+// race a bounded DFS per core and keep the shortest schedule any of them found
+int schedule_solve_portfolio(Task_Memory* task_memory, Schedule_Event_List* schedule_best, Schedule_Event_List* schedule_working){
+  uint64_t cpu_timer_start = SDL_GetPerformanceCounter();
+  Task** order = (Task**) malloc(task_memory->allocation_used * sizeof(Task*));
+  size_t order_qty;
+  if (schedule_list_prepare(task_memory, order, &order_qty) == FAILURE){
+    // a prereq loop, a single search will report it
+    free(order);
+    return schedule_solve(task_memory, schedule_best, schedule_working, SCHEDULE_SOLVER_PORTFOLIO);
+  }
+
+  Schedule_Portfolio portfolio;
+  portfolio.qty = SDL_GetCPUCount();
+  if (portfolio.qty > SCHEDULE_PORTFOLIO_MAX){
+    portfolio.qty = SCHEDULE_PORTFOLIO_MAX;
+  }
+  SDL_AtomicSet(&portfolio.next, 0);
+  SDL_AtomicSet(&portfolio.incumbent, SDL_MAX_SINT32);
+  SDL_AtomicSet(&portfolio.stop, 0);
+  portfolio.lock = SDL_CreateMutex();
+  portfolio.done = SDL_CreateCond();
+  portfolio.finished_qty = 0;
+  portfolio.published = UINT64_MAX;
+  uint8_t watched = (schedule_working->progress != NULL);
+  schedule_working->timer_start = cpu_timer_start;
+
+  // the whole project is one island to each instance
+  size_t* island = (size_t*) malloc(task_memory->allocation_total * sizeof(size_t));
+  memset(island, 0, task_memory->allocation_total * sizeof(size_t));
+  for (size_t k=0; k<portfolio.qty; ++k){
+    schedule_portfolio_order(task_memory, order, k);
+    portfolio.instances[k] = schedule_island_split(task_memory, island, 1, order, schedule_working);
+    portfolio.instances[k]->working->cancel = &portfolio.stop;
+    portfolio.instances[k]->working->incumbent = &portfolio.incumbent;
+    if (watched == TRUE){
+      portfolio.instances[k]->progress = schedule_create();
+      portfolio.instances[k]->working->progress = portfolio.instances[k]->progress;
+      portfolio.instances[k]->working->progress_lock = portfolio.lock;
+    }
+    portfolio.finished_search[k] = FALSE;
+  }
+  free(island);
+  free(order);
+
+  printf("[SCHEDULER] racing %lu searches\n", portfolio.qty);
+  SDL_Thread* threads[SCHEDULE_PORTFOLIO_MAX];
+  for (size_t k=0; k<portfolio.qty; ++k){
+    threads[k] = SDL_CreateThread(schedule_portfolio_run, "schedule_portfolio", (void*) &portfolio);
+  }
+  // this thread passes a cancel from the caller on to the instances, and better schedules back to the caller
+  SDL_LockMutex(portfolio.lock);
+  while (portfolio.finished_qty < portfolio.qty){
+    SDL_CondWaitTimeout(portfolio.done, portfolio.lock, SCHEDULE_ISLAND_WATCH_MS);
+    if ((schedule_working->cancel != NULL) && (SDL_AtomicGet(schedule_working->cancel) != 0)){
+      SDL_AtomicSet(&portfolio.stop, 1);
+    }
+    if (watched == TRUE){
+      schedule_portfolio_progress(&portfolio, schedule_working);
+    }
+  }
+  SDL_UnlockMutex(portfolio.lock);
+  for (size_t k=0; k<portfolio.qty; ++k){
+    SDL_WaitThread(threads[k], NULL);
+  }
+  SDL_DestroyCond(portfolio.done);
+  SDL_DestroyMutex(portfolio.lock);
+
+  // pick the winner. a finished search proves the shared best optimal, whichever instance found it
+  Schedule_Island* winner = NULL;
+  size_t winner_k = 0;
+  schedule_best->qty = 0;
+  schedule_best->solved = FALSE;
+  schedule_best->solver = SCHEDULE_SOLVER_PORTFOLIO;
+  schedule_best->search_nodes = 0;
+  schedule_best->search_prunes = 0;
+  schedule_best->repaired_qty = 0;
+  memset(&schedule_best->stats, 0, sizeof(Schedule_Stats));
+  schedule_best->improvements = 0;
+  schedule_best->timed_out = FALSE;
+  schedule_best->optimal = FALSE;
+  for (size_t k=0; k<portfolio.qty; ++k){
+    Schedule_Island* instance = portfolio.instances[k];
+    schedule_best->search_nodes += instance->best->search_nodes;
+    schedule_best->search_prunes += instance->best->search_prunes;
+    schedule_stats_add(&schedule_best->stats, &instance->best->stats);
+    schedule_best->improvements += instance->best->improvements;
+    if (instance->best->timed_out == TRUE){
+      schedule_best->timed_out = TRUE;
+    }
+    if (portfolio.finished_search[k] == TRUE){
+      schedule_best->optimal = TRUE;
+    }
+    if ((instance->status == SUCCESS) && ((winner == NULL) || (instance->best->day_duration < winner->best->day_duration))){
+      winner = instance;
+      winner_k = k;
+    }
+  }
+  if (winner != NULL){
+    schedule_island_merge(winner, schedule_best);
+    schedule_best->solved = TRUE;
+  }
+  for (size_t k=0; k<portfolio.qty; ++k){
+    schedule_island_free(portfolio.instances[k], 1);
+  }
+
+  uint64_t cpu_timer_end = SDL_GetPerformanceCounter();
+  double cpu_timer_elapsed = ((double) cpu_timer_end - cpu_timer_start) / ((double) SDL_GetPerformanceFrequency());
+  schedule_best->solve_time_ms = cpu_timer_elapsed*1000;
+
+  if (schedule_best->solved == FALSE){
+    schedule_best->optimal = FALSE;
+    printf("[SCHEDULER] portfolio solve done: FAILURE. time: %.3lf ms\n", cpu_timer_elapsed*1000);
+    return FAILURE;
+  }
+  schedule_calculate_duration(schedule_best, task_memory);
+  schedule_signature_record(task_memory);
+  printf("[SCHEDULER] portfolio solve done: SUCCESS, instance %lu won. time: %.3lf ms, nodes: %lu, pruned: %lu\n", winner_k, cpu_timer_elapsed*1000, schedule_best->search_nodes, schedule_best->search_prunes);
+  return SUCCESS;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// PARALLEL DFS
+// the threads of the work-stealing search, see PARALLEL SEARCH. the search space and pruning are those of the
+// bounded DFS, with the best duration shared between threads, so a search that runs to the end is optimal
+
+// a job from this thread's deque, or else the oldest job of the next thread that has one
+Schedule_Search_Job* schedule_search_job_next(Schedule_Search_Worker* worker){
+  Schedule_Search_Job* job = schedule_search_deque_pop(&worker->deque);
+  for (size_t i=1; (job == NULL) && (i<worker->search->qty); ++i){
+    Schedule_Search_Worker* victim = worker->search->workers + (worker->index + i) % worker->search->qty;
+    job = schedule_search_deque_steal(&victim->deque);
+  }
+  return job;
+}
+
+
+int schedule_search_run(void* data){
+  Schedule_Search_Worker* worker = (Schedule_Search_Worker*) data;
+  Schedule_Search* search = worker->search;
+  Schedule_Island* copy = worker->copy;
+  uint8_t hungry = FALSE;
+  while (SDL_AtomicGet(&search->outstanding) > 0){
+    Schedule_Search_Job* job = schedule_search_job_next(worker);
+    if (job == NULL){
+      if (hungry == FALSE){
+        SDL_AtomicAdd(&search->hungry, 1);
+        hungry = TRUE;
+      }
+      // look again under the lock, a job shared or the search ending in between still wakes this thread
+      SDL_LockMutex(search->idle_lock);
+      job = schedule_search_job_next(worker);
+      if ((job == NULL) && (SDL_AtomicGet(&search->outstanding) > 0)){
+        SDL_CondWait(search->work, search->idle_lock);
+      }
+      SDL_UnlockMutex(search->idle_lock);
+      if (job == NULL){
+        continue;
+      }
+    }
+    if (hungry == TRUE){
+      SDL_AtomicAdd(&search->hungry, -1);
+      hungry = FALSE;
+    }
+
+    schedule_search_job_restore(&copy->task_memory, copy->working, job);
+    schedule_search_job_free(job);
+    schedule_solve_iter(&copy->task_memory, copy->best, copy->working);
+    if (SDL_AtomicAdd(&search->outstanding, -1) == 1){
+      SDL_LockMutex(search->idle_lock);
+      SDL_CondBroadcast(search->work);
+      SDL_UnlockMutex(search->idle_lock);
+    }
+  }
+  if (hungry == TRUE){
+    SDL_AtomicAdd(&search->hungry, -1);
+  }
+  return 0;
+}
+
+
+// the bounded DFS with its subtrees spread over every core
+int schedule_solve_parallel(Task_Memory* task_memory, Schedule_Event_List* schedule_best, Schedule_Event_List* schedule_working){
+  uint64_t cpu_timer_start = SDL_GetPerformanceCounter();
+  schedule_best->qty = 0;
+  schedule_best->solved = FALSE;
+  schedule_working->solver = SCHEDULE_SOLVER_DFS_BOUNDED;
+  schedule_working->timer_start = cpu_timer_start;
+  schedule_working->search_nodes = 0;
+  memset(&schedule_working->stats, 0, sizeof(Schedule_Stats));
+  schedule_working->improvements = 0;
+  schedule_working->timed_out = FALSE;
+  uint64_t lap = cpu_timer_start;
+
+  Schedule_Search* search = (Schedule_Search*) malloc(sizeof(Schedule_Search));
+  search->qty = SDL_GetCPUCount();
+  if (search->qty > SCHEDULE_SEARCH_THREADS_MAX){
+    search->qty = SCHEDULE_SEARCH_THREADS_MAX;
+  }
+  SDL_AtomicSet(&search->outstanding, 1);
+  SDL_AtomicSet(&search->hungry, 0);
+  SDL_AtomicSet(&search->incumbent, SDL_MAX_SINT32);
+  search->idle_lock = SDL_CreateMutex();
+  search->work = SDL_CreateCond();
+
+  // the bounds and windows go into the task copies, and the quick list schedule sets the bar for everyone
+  schedule_bounds_prepare(task_memory, schedule_working);
+  schedule_stats_lap(&schedule_working->stats, SCHEDULE_PHASE_PREPARE, &lap);
+  if (schedule_windows_prepare(task_memory) == FAILURE){
+    SDL_DestroyCond(search->work);
+    SDL_DestroyMutex(search->idle_lock);
+    free(search);
+    return schedule_solve(task_memory, schedule_best, schedule_working, SCHEDULE_SOLVER_DFS_PARALLEL);
+  }
+  schedule_stats_lap(&schedule_working->stats, SCHEDULE_PHASE_WINDOWS, &lap);
+  if (schedule_working->time_budget_ms > 0){
+    schedule_solve_prepare(task_memory, schedule_working);
+    schedule_solve_list(task_memory, schedule_best, schedule_working, SCHEDULE_SOLVER_LIST_PATH);
+    if ((schedule_best->solved == TRUE) && (schedule_best->day_duration < (uint64_t) SDL_MAX_SINT32)){
+      SDL_AtomicSet(&search->incumbent, (int) schedule_best->day_duration);
+    }
+    schedule_stats_lap(&schedule_working->stats, SCHEDULE_PHASE_SEED, &lap);
+  }
+
+  size_t* island = (size_t*) malloc(task_memory->allocation_total * sizeof(size_t));
+  memset(island, 0, task_memory->allocation_total * sizeof(size_t));
+  for (size_t i=0; i<search->qty; ++i){
+    Schedule_Search_Worker* worker = search->workers + i;
+    worker->search = search;
+    worker->index = i;
+    worker->deque.top = 0;
+    worker->deque.bottom = 0;
+    worker->deque.lock = 0;
+    worker->copy = schedule_island_split(task_memory, island, 1, NULL, schedule_working);
+    worker->copy->working->solver = SCHEDULE_SOLVER_DFS_BOUNDED;
+    worker->copy->working->bound_workload = schedule_working->bound_workload;
+    worker->copy->working->timer_start = cpu_timer_start;
+    worker->copy->working->incumbent = &search->incumbent;
+    worker->copy->working->search = worker;
+  }
+  free(island);
+
+  // the whole search is the first job
+  Schedule_Island* first = search->workers[0].copy;
+  schedule_solve_prepare(&first->task_memory, first->working);
+  schedule_search_deque_push(&search->workers[0].deque, schedule_search_job_take(&first->task_memory, first->working));
+
+  printf("[SCHEDULER] searching on %lu threads\n", search->qty);
+  SDL_Thread* threads[SCHEDULE_SEARCH_THREADS_MAX];
+  for (size_t i=1; i<search->qty; ++i){
+    threads[i] = SDL_CreateThread(schedule_search_run, "schedule_search", (void*) (search->workers + i));
+  }
+  schedule_search_run((void*) search->workers); // this thread works too
+  for (size_t i=1; i<search->qty; ++i){
+    SDL_WaitThread(threads[i], NULL);
+  }
+  schedule_stats_lap(&schedule_working->stats, SCHEDULE_PHASE_SEARCH, &lap);
+
+  // the shortest schedule of any thread wins, unless the list schedule was never beaten
+  Schedule_Island* winner = NULL;
+  uint64_t search_nodes = 0;
+  uint64_t search_prunes = 0;
+  uint64_t improvements = schedule_working->improvements;
+  for (size_t i=0; i<search->qty; ++i){
+    Schedule_Island* copy = search->workers[i].copy;
+    search_nodes += copy->working->search_nodes;
+    search_prunes += copy->working->search_prunes;
+    improvements += copy->working->improvements;
+    schedule_stats_add(&schedule_working->stats, &copy->working->stats);
+    if (copy->working->timed_out == TRUE){
+      schedule_working->timed_out = TRUE;
+    }
+    if ((copy->best->solved == TRUE) && ((winner == NULL) || (copy->best->day_duration < winner->best->day_duration))){
+      winner = copy;
+    }
+  }
+  if ((winner != NULL) && ((schedule_best->solved == FALSE) || (winner->best->day_duration < schedule_best->day_duration))){
+    schedule_best_events(&winner->task_memory, winner->best);
+    schedule_best->qty = 0;
+    schedule_island_merge(winner, schedule_best);
+    schedule_best->solved = TRUE;
+    schedule_calculate_duration(schedule_best, task_memory);
+  }
+  else if (schedule_best->solved == TRUE){
+    schedule_best_events(task_memory, schedule_best);
+  }
+  for (size_t i=0; i<search->qty; ++i){
+    schedule_island_free(search->workers[i].copy, 1);
+  }
+  SDL_DestroyCond(search->work);
+  SDL_DestroyMutex(search->idle_lock);
+  free(search);
+
+  uint64_t cpu_timer_end = SDL_GetPerformanceCounter();
+  double cpu_timer_elapsed = ((double) cpu_timer_end - cpu_timer_start) / ((double) SDL_GetPerformanceFrequency());
+  uint8_t cancelled = ((schedule_working->cancel != NULL) && (SDL_AtomicGet(schedule_working->cancel) != 0));
+  schedule_best->solver = SCHEDULE_SOLVER_DFS_PARALLEL;
+  schedule_best->solve_time_ms = cpu_timer_elapsed*1000;
+  schedule_best->search_nodes = search_nodes;
+  schedule_best->search_prunes = search_prunes;
+  schedule_best->repaired_qty = 0;
+  schedule_best->improvements = improvements;
+  schedule_best->timed_out = schedule_working->timed_out;
+  schedule_best->optimal = ((schedule_best->solved == TRUE) && (schedule_working->timed_out == FALSE) && (cancelled == FALSE));
+
+  if (schedule_best->solved == TRUE){
+    schedule_signature_record(task_memory);
+  }
+  schedule_stats_lap(&schedule_working->stats, SCHEDULE_PHASE_FINISH, &lap);
+  schedule_best->stats = schedule_working->stats;
+
+  if (schedule_best->solved == FALSE){
+    printf("[SCHEDULER] parallel solve done: FAILURE. time: %.3lf ms, nodes: %lu, pruned: %lu\n", cpu_timer_elapsed*1000, search_nodes, search_prunes);
     return FAILURE;
   }
+  printf("[SCHEDULER] parallel solve done: SUCCESS. time: %.3lf ms, nodes: %lu, pruned: %lu\n", cpu_timer_elapsed*1000, search_nodes, search_prunes);
+  return SUCCESS;
+}
+
+
+// a full solve the way the editor runs it: the threaded solvers spread their own search, the rest are split into islands
+int schedule_solve_threaded(Task_Memory* task_memory, Schedule_Event_List* schedule_best, Schedule_Event_List* schedule_working, uint8_t solver){
+  if (solver == SCHEDULE_SOLVER_PORTFOLIO){
+    return schedule_solve_portfolio(task_memory, schedule_best, schedule_working);
+  }
+  else if (solver == SCHEDULE_SOLVER_DFS_PARALLEL){
+    return schedule_solve_parallel(task_memory, schedule_best, schedule_working);
+  }
+  return schedule_solve_islands(task_memory, schedule_best, schedule_working, solver);
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// BACKGROUND SOLVER
+// the editor hands a private copy of the tasks and users to a worker thread and keeps drawing the last good schedule
+// a newer request cancels the running search, only the answer for the latest request gets published
+
+typedef struct Schedule_Snapshot{
+  Task_Memory task_memory;
+  User* users;
+  size_t user_allocation_total;
+  char* names; // task and user names, so the editor can free or rename its own
+  size_t names_length;
+  Schedule_Event_List* best;
+  Schedule_Event_List* working;
+  uint8_t solver;
+  uint8_t incremental;
+  uint64_t generation;
+  int status;
+} Schedule_Snapshot;
+
+typedef struct Schedule_Worker{
+  SDL_Thread* thread;
+  SDL_mutex* lock;
+  SDL_cond* wake;
+  SDL_atomic_t cancel;
+  uint8_t quit;
+
+  // every snapshot is either free, or in exactly one of these
+  Schedule_Snapshot snapshots[3];
+  Schedule_Snapshot* pending; // waiting for the worker
+  Schedule_Snapshot* running; // being solved right now
+  Schedule_Snapshot* done; // solved, waiting to be collected
+
+  uint64_t generation; // latest request
+  uint64_t generation_published; // request behind the schedule on screen
+
+  // better schedules found while the search is still running
+  Schedule_Event_List* progress;
+  Task* progress_tasks; // task array the progress events point into
+  uint64_t progress_generation;
+  uint64_t progress_collected; // improvements already shown
+} Schedule_Worker;
+
+
+void schedule_snapshot_free(Schedule_Snapshot* snap){
+  free(snap->task_memory.tasks);
+  free(snap->task_memory.schedule_ready);
+  free(snap->task_memory.schedule_pending);
+  free(snap->users);
+  free(snap->names);
+  schedule_free(snap->best);
+  schedule_free(snap->working);
+}
+
+
+// copy everything the solver reads, and point the copies at each other instead of at the live model
+void schedule_snapshot_take(Schedule_Snapshot* snap, Task_Memory* task_memory, User_Memory* user_memory, Schedule_Event_List* schedule_best){
+  Task_Memory* tm = &snap->task_memory;
+  if (tm->allocation_total != task_memory->allocation_total){
+    tm->allocation_total = task_memory->allocation_total;
+    tm->tasks = (Task*) realloc(tm->tasks, tm->allocation_total * sizeof(Task));
+    tm->schedule_ready = (uint64_t*) realloc(tm->schedule_ready, schedule_ready_words(tm->allocation_total) * sizeof(uint64_t));
+    tm->schedule_pending = (uint64_t*) realloc(tm->schedule_pending, schedule_ready_words(tm->allocation_total) * sizeof(uint64_t));
+  }
+  tm->allocation_used = task_memory->allocation_used;
+  memcpy(tm->tasks, task_memory->tasks, tm->allocation_total * sizeof(Task));
+
+  if (snap->user_allocation_total != user_memory->allocation_total){
+    snap->user_allocation_total = user_memory->allocation_total;
+    snap->users = (User*) realloc(snap->users, snap->user_allocation_total * sizeof(User));
+  }
+  memcpy(snap->users, user_memory->users, snap->user_allocation_total * sizeof(User));
+
+  size_t names_length = 0;
+  for (size_t t=0; t<tm->allocation_total; ++t){
+    if (tm->tasks[t].trash == FALSE){
+      names_length += tm->tasks[t].task_name_length + 1;
+    }
+  }
+  for (size_t u=0; u<snap->user_allocation_total; ++u){
+    if (snap->users[u].trash == FALSE){
+      names_length += snap->users[u].name_length + 1;
+    }
+  }
+  if (names_length > snap->names_length){
+    snap->names_length = names_length;
+    snap->names = (char*) realloc(snap->names, snap->names_length);
+  }
+
+  char* name = snap->names;
+  for (size_t t=0; t<tm->allocation_total; ++t){
+    Task* task = tm->tasks + t;
+    if (task->trash == FALSE){
+      memcpy(name, task->task_name, task->task_name_length);
+      name[task->task_name_length] = '\0';
+      task->task_name = name;
+      name += task->task_name_length + 1;
+
+      for (size_t i=0; i<task->user_qty; ++i){
+        task->users[i] = snap->users + (task->users[i] - user_memory->users);
+      }
+      for (size_t i=0; i<task->prereq_qty; ++i){
+        task->prereqs[i] = tm->tasks + (task->prereqs[i] - task_memory->tasks);
+      }
+      for (size_t i=0; i<task->dependent_qty; ++i){
+        task->dependents[i] = tm->tasks + (task->dependents[i] - task_memory->tasks);
+      }
+      task->dependents_display_qty = 0;
+    }
+  }
+  for (size_t u=0; u<snap->user_allocation_total; ++u){
+    User* user = snap->users + u;
+    if (user->trash == TRUE){
+      user->name = NULL;
+    }
+    else{
+      memcpy(name, user->name, user->name_length);
+      name[user->name_length] = '\0';
+      user->name = name;
+      name += user->name_length + 1;
+      for (size_t i=0; i<user->task_qty; ++i){
+        user->tasks[i] = tm->tasks + (user->tasks[i] - task_memory->tasks);
+      }
+    }
+  }
+
+  // an incremental solve diffs against the last schedule, so it needs that too
+  schedule_copy(snap->best, schedule_best);
+  for (size_t e=0; e<snap->best->qty; ++e){
+    Task* task = snap->best->events[e].task;
+    if ((task < task_memory->tasks) || (task >= task_memory->tasks + task_memory->allocation_total)){
+      snap->best->solved = FALSE; // the task array moved since, start over
+      break;
+    }
+    snap->best->events[e].task = tm->tasks + (task - task_memory->tasks);
+  }
+}
+
+
+// write a schedule solved on a snapshot back onto the live model. only valid if nothing was edited since the snapshot
+void schedule_snapshot_publish(Schedule_Event_List* solved, Task* snapshot_tasks, Task_Memory* task_memory, Schedule_Event_List* schedule_best){
+  schedule_copy(schedule_best, solved);
+  for (size_t e=0; e<schedule_best->qty; ++e){
+    Task* task = task_memory->tasks + (schedule_best->events[e].task - snapshot_tasks);
+    schedule_best->events[e].task = task;
+    if (schedule_best->solved == TRUE){
+      task->day_start = schedule_best->events[e].date;
+      task->day_end = task->day_start + task->day_duration - 1;
+    }
+  }
+  if (schedule_best->solved == TRUE){
+    schedule_signature_record(task_memory);
+  }
+}
+
+
+int schedule_worker_run(void* data){
+  Schedule_Worker* worker = (Schedule_Worker*) data;
+  SDL_LockMutex(worker->lock);
+  while (worker->quit == FALSE){
+    if (worker->pending == NULL){
+      SDL_CondWait(worker->wake, worker->lock);
+      continue;
+    }
+    Schedule_Snapshot* job = worker->pending;
+    worker->pending = NULL;
+    worker->running = job;
+    worker->progress->solved = FALSE;
+    worker->progress->improvements = 0;
+    worker->progress_tasks = job->task_memory.tasks;
+    worker->progress_generation = job->generation;
+    worker->progress_collected = 0;
+    SDL_AtomicSet(&worker->cancel, 0);
+    SDL_UnlockMutex(worker->lock);
+
+    if (job->incremental == TRUE){
+      job->status = schedule_solve_incremental(&job->task_memory, job->best, job->working, job->solver);
+    }
+    else{
+      job->status = schedule_solve_threaded(&job->task_memory, job->best, job->working, job->solver);
+    }
+
+    SDL_LockMutex(worker->lock);
+    worker->running = NULL;
+    if (job->generation == worker->generation){
+      worker->done = job;
+    }
+  }
+  SDL_UnlockMutex(worker->lock);
+  return 0;
+}
+
+
+Schedule_Worker* schedule_worker_create(){
+  Schedule_Worker* worker = (Schedule_Worker*) malloc(sizeof(Schedule_Worker));
+  memset(worker, 0, sizeof(Schedule_Worker));
+  worker->lock = SDL_CreateMutex();
+  worker->progress = schedule_create();
+  for (size_t i=0; i<3; ++i){
+    worker->snapshots[i].best = schedule_create();
+    worker->snapshots[i].working = schedule_create();
+    worker->snapshots[i].working->cancel = &worker->cancel;
+    worker->snapshots[i].working->progress = worker->progress;
+    worker->snapshots[i].working->progress_lock = worker->lock;
+  }
+  worker->wake = SDL_CreateCond();
+  worker->thread = SDL_CreateThread(schedule_worker_run, "schedule_worker", (void*) worker);
+  return worker;
+}
+
 
+void schedule_worker_free(Schedule_Worker* worker){
+  SDL_LockMutex(worker->lock);
+  worker->quit = TRUE;
+  SDL_AtomicSet(&worker->cancel, 1);
+  SDL_CondSignal(worker->wake);
+  SDL_UnlockMutex(worker->lock);
+  SDL_WaitThread(worker->thread, NULL);
+
+  for (size_t i=0; i<3; ++i){
+    schedule_snapshot_free(worker->snapshots + i);
+  }
+  schedule_free(worker->progress);
+  SDL_DestroyCond(worker->wake);
+  SDL_DestroyMutex(worker->lock);
+  free(worker);
+}
+
+
+// ask for a new solve of the live model. whatever the worker is doing now gets cancelled
+// time_budget_ms of 0 searches until done
+void schedule_worker_request(Schedule_Worker* worker, Task_Memory* task_memory, User_Memory* user_memory, Schedule_Event_List* schedule_best, uint8_t solver, uint8_t incremental, double time_budget_ms){
+  SDL_LockMutex(worker->lock);
+  Schedule_Snapshot* snap = worker->pending;
+  for (size_t i=0; (snap == NULL) && (i<3); ++i){
+    if ((worker->snapshots + i != worker->running) && (worker->snapshots + i != worker->done)){
+      snap = worker->snapshots + i;
+    }
+  }
+  worker->done = NULL; // about to be out of date anyway
+  worker->generation += 1;
+
+  schedule_snapshot_take(snap, task_memory, user_memory, schedule_best);
+  snap->solver = solver;
+  snap->incremental = incremental;
+  snap->working->time_budget_ms = time_budget_ms;
+  snap->generation = worker->generation;
+  worker->pending = snap;
+
+  SDL_AtomicSet(&worker->cancel, 1);
+  SDL_CondSignal(worker->wake);
+  SDL_UnlockMutex(worker->lock);
+}
+
+
+// pick up a finished solve, or a better schedule from one still running, for the latest request
+// returns TRUE if schedule_best changed
+int schedule_worker_collect(Schedule_Worker* worker, Task_Memory* task_memory, Schedule_Event_List* schedule_best, int* status){
+  int collected = FALSE;
+  SDL_LockMutex(worker->lock);
+  if ((worker->done != NULL) && (worker->done->generation == worker->generation)){
+    schedule_snapshot_publish(worker->done->best, worker->done->task_memory.tasks, task_memory, schedule_best);
+    *status = worker->done->status;
+    worker->generation_published = worker->done->generation;
+    worker->progress_collected = worker->progress->improvements; // already included
+    collected = TRUE;
+  }
+  else if ((worker->progress_generation == worker->generation) && (worker->progress->improvements > worker->progress_collected)){
+    schedule_snapshot_publish(worker->progress, worker->progress_tasks, task_memory, schedule_best);
+    *status = SUCCESS;
+    worker->progress_collected = worker->progress->improvements;
+    collected = TRUE;
+  }
+  worker->done = NULL;
+  SDL_UnlockMutex(worker->lock);
+  return collected;
 }
+
+
+// TRUE while the schedule on screen is behind the text
+int schedule_worker_stale(Schedule_Worker* worker){
+  return (worker->generation_published != worker->generation);
+}
+
+#endif